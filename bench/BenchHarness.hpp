@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench{
+
+    /**
+    * @brief Timing of one benchmark case.
+    */
+    struct Result{
+        std::string name;
+        /**
+        * @brief Size parameter of the case (items in the tree or on the page).
+        */
+        std::size_t items;
+        /**
+        * @brief Operations timed per round.
+        */
+        std::size_t operations;
+        int rounds;
+        double bestNs;
+        double medianNs;
+    };
+
+    /**
+    * @brief Runs benchmark cases and reports them as a table or as JSON.
+    *
+    * Every case is timed for several rounds; the best and the median round,
+    * divided by the count of operations, are reported. Inputs are built from
+    * fixed sequences, so runs differ only by timing noise.
+    */
+    class Harness{
+        private:
+            std::vector<Result> m_results {};
+            std::string m_filter {};
+
+        public:
+            explicit Harness(std::string filter = {}) : m_filter(std::move(filter)) {}
+
+            /**
+            * @brief Tells whether a case runs with the current filter
+            */
+            bool enabled(const std::string& name) const{
+                return m_filter.empty() || name.find(m_filter) != std::string::npos;
+            }
+
+            /**
+            * @brief Times a round function and records the result
+            *
+            * @param name case name, dotted like "navigator.next"
+            * @param items size parameter of the case
+            * @param operations operations done by one call of round
+            * @param rounds count of timed calls
+            * @param round function doing the operations
+            * @param setup called untimed before every round, may be empty
+            */
+            void run(const std::string& name, std::size_t items, std::size_t operations, int rounds,
+                     const std::function<void()>& round, const std::function<void()>& setup = {}){
+                if(!enabled(name)){
+                    return;
+                }
+
+                std::vector<double> samples;
+                samples.reserve(rounds);
+                for(int i = 0; i < rounds; ++i){
+                    if(setup){
+                        setup();
+                    }
+                    auto start = std::chrono::steady_clock::now();
+                    round();
+                    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                    samples.push_back(elapsed.count() / static_cast<double>(operations));
+                }
+
+                std::sort(samples.begin(), samples.end());
+                m_results.push_back({name, items, operations, rounds, samples.front(), samples[samples.size() / 2]});
+
+                const Result& result = m_results.back();
+                std::fprintf(stderr, "%-36s %9zu %12.2f %12.2f\n",
+                             result.name.c_str(), result.items, result.bestNs, result.medianNs);
+            }
+
+            const std::vector<Result>& getResults() const{
+                return m_results;
+            }
+
+            /**
+            * @brief Writes all results as one JSON document
+            *
+            * @param out file to write to
+            * @param buildType CMake build type the benchmark was compiled with
+            */
+            void writeJson(std::FILE* out, const char* buildType) const{
+                std::fprintf(out, "{\n  \"benchmark\": \"menulib_bench\",\n");
+                std::fprintf(out, "  \"build_type\": \"%s\",\n", buildType);
+#if defined(__clang__)
+                std::fprintf(out, "  \"compiler\": \"clang %d.%d.%d\",\n", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+                std::fprintf(out, "  \"compiler\": \"gcc %d.%d.%d\",\n", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#else
+                std::fprintf(out, "  \"compiler\": \"unknown\",\n");
+#endif
+                std::fprintf(out, "  \"unit\": \"ns/op\",\n  \"results\": [");
+                for(std::size_t i = 0; i < m_results.size(); ++i){
+                    const Result& result = m_results[i];
+                    // case names are plain identifiers, no escaping needed
+                    std::fprintf(out, "%s\n    {\"name\": \"%s\", \"items\": %zu, \"operations\": %zu, \"rounds\": %d, "
+                                      "\"best\": %.3f, \"median\": %.3f}",
+                                 i == 0 ? "" : ",", result.name.c_str(), result.items, result.operations,
+                                 result.rounds, result.bestNs, result.medianNs);
+                }
+                std::fprintf(out, "\n  ]\n}\n");
+            }
+    };
+}
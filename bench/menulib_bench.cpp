@@ -0,0 +1,387 @@
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.hpp"
+
+#include "menulib/MenuPage.hpp"
+#include "menulib/MenuOption.hpp"
+#include "menulib/MenuToggle.hpp"
+#include "menulib/MenuSlider.hpp"
+#include "menulib/MenuNavigator.hpp"
+#include "menulib/MenuRenderer.hpp"
+#include "menulib/VariantMenuPage.hpp"
+
+// Micro and macro benchmarks of menulib: tree construction and destruction,
+// navigation, slider changes, rendering and item dispatch through virtual
+// IMenuItem calls compared to a VariantMenuPage.
+//
+// Usage: menulib_bench [--json FILE|-] [--filter TEXT] [--quick]
+//   --json    writes results as JSON to FILE, "-" for standard output
+//   --filter  runs only cases whose name contains TEXT
+//   --quick   skips the 1M item tree
+//
+// A table is always printed to standard error. Build with optimizations
+// (-DCMAKE_BUILD_TYPE=Release) for meaningful numbers.
+
+#ifndef MENULIB_BENCH_BUILD_TYPE
+#define MENULIB_BENCH_BUILD_TYPE ""
+#endif
+
+namespace{
+    constexpr int PageItems = 1024;
+    constexpr int PageRounds = 15;
+    constexpr int PagePasses = 16;
+    constexpr int ChildrenPerPage = 16;
+
+    volatile long sink = 0;
+
+    /**
+    * @brief Stream buffer dropping everything, so rendering is timed without the terminal
+    */
+    class NullBuffer : public std::streambuf{
+        protected:
+            int overflow(int c) override{
+                return c;
+            }
+
+            std::streamsize xsputn(const char*, std::streamsize count) override{
+                return count;
+            }
+    };
+
+    /**
+    * @brief Kind of the i-th item, mixed pseudo-randomly so no path gets a predictable pattern
+    */
+    int kindOf(int i){
+        unsigned hash = static_cast<unsigned>(i) * 2654435761u;
+        return static_cast<int>((hash >> 16) % 3);
+    }
+
+    mr::IMenuItem* makeItem(int i, const std::string& label){
+        switch(kindOf(i)){
+            case 0: return new mr::MenuOption(label, [](){ sink = sink + 1; });
+            case 1: return new mr::MenuToggle(label, false, [](bool){});
+            default: return new mr::MenuSlider<int>(label, 50, 0, 100, 1, [](int){});
+        }
+    }
+
+    /**
+    * @brief Fills a page with options, toggles and int sliders
+    */
+    void fillHeap(mr::MenuPage& page, int count){
+        for(int i = 0; i < count; ++i){
+            page.addItem(makeItem(i, "Item " + std::to_string(i)));
+        }
+    }
+
+    void fillVariant(mr::VariantMenuPage& page, int count){
+        for(int i = 0; i < count; ++i){
+            std::string label = "Item " + std::to_string(i);
+            switch(kindOf(i)){
+                case 0: page.emplace<mr::MenuOption>(label, [](){ sink = sink + 1; }); break;
+                case 1: page.emplace<mr::MenuToggle>(label, false, [](bool){}); break;
+                default: page.emplace<mr::MenuSlider<int>>(label, 50, 0, 100, 1, [](int){}); break;
+            }
+        }
+    }
+
+    /**
+    * @brief Builds a tree of leaf items grouped ChildrenPerPage to a page under one root
+    *
+    * @param labels label of every leaf, prepared outside the timed region
+    */
+    std::unique_ptr<mr::MenuPage> buildTree(const std::vector<std::string>& labels){
+        auto root = std::make_unique<mr::MenuPage>("Root");
+        mr::MenuPage* page = nullptr;
+        for(std::size_t i = 0; i < labels.size(); ++i){
+            if(i % ChildrenPerPage == 0){
+                page = new mr::MenuPage("Page", root.get());
+                root->addItem(page);
+            }
+            page->addItem(makeItem(static_cast<int>(i), labels[i]));
+        }
+        return root;
+    }
+
+    void benchTree(bench::Harness& harness, std::size_t items, int rounds){
+        std::string suffix = std::to_string(items);
+        if(!harness.enabled("tree.construct." + suffix) && !harness.enabled("tree.destroy." + suffix)){
+            return;
+        }
+
+        std::vector<std::string> labels(items);
+        for(std::size_t i = 0; i < items; ++i){
+            labels[i] = "Item " + std::to_string(i);
+        }
+
+        std::unique_ptr<mr::MenuPage> tree;
+        harness.run("tree.construct." + suffix, items, items, rounds,
+            [&](){ tree = buildTree(labels); },
+            [&](){ tree.reset(); });
+        harness.run("tree.destroy." + suffix, items, items, rounds,
+            [&](){ tree.reset(); },
+            [&](){ tree = buildTree(labels); });
+    }
+
+    void benchNavigator(bench::Harness& harness){
+        mr::MenuPage page("Page");
+        fillHeap(page, PageItems);
+        mr::MenuNavigator navigator(&page);
+        std::size_t moves = static_cast<std::size_t>(PageItems) * PagePasses;
+
+        harness.run("navigator.next", PageItems, moves, PageRounds, [&](){
+            for(std::size_t i = 0; i < moves; ++i){
+                navigator.next();
+            }
+        });
+        harness.run("navigator.previous", PageItems, moves, PageRounds, [&](){
+            for(std::size_t i = 0; i < moves; ++i){
+                navigator.previous();
+            }
+        });
+
+        // every item is a submenu, a select enters it and a back returns
+        mr::MenuPage root("Root");
+        for(int i = 0; i < PageItems; ++i){
+            auto* submenu = new mr::MenuPage("Submenu " + std::to_string(i), &root);
+            submenu->addItem(new mr::MenuOption("Item", [](){}));
+            root.addItem(submenu);
+        }
+        mr::MenuNavigator submenus(&root);
+
+        harness.run("navigator.select_back", PageItems, PageItems, PageRounds, [&](){
+            for(int i = 0; i < PageItems; ++i){
+                submenus.select();
+                submenus.back();
+                submenus.next();
+            }
+        });
+
+        // history steps restore the highlight of both pages
+        submenus.select();
+        harness.run("navigator.back_forward", PageItems, moves, PageRounds, [&](){
+            for(std::size_t i = 0; i < moves; ++i){
+                submenus.back();
+                submenus.forward();
+            }
+        });
+        submenus.back();
+
+        // options run their function on select
+        harness.run("navigator.select_option", PageItems, moves, PageRounds, [&](){
+            for(std::size_t i = 0; i < moves; ++i){
+                navigator.select();
+                navigator.next();
+            }
+        });
+    }
+
+    template <typename T>
+    void benchSlider(bench::Harness& harness, const char* type, T step){
+        std::string name = std::string("slider.left_right_label.") + type;
+        mr::MenuSlider<T> slider("Volume", T{}, T{}, step * 100, step, [](T){});
+        std::size_t moves = static_cast<std::size_t>(PageItems) * PagePasses;
+
+        // a step right and back leaves the slider where it was, the label is rebuilt after each
+        harness.run(name, 1, moves, PageRounds, [&](){
+            std::size_t length = 0;
+            for(std::size_t i = 0; i < moves; i += 2){
+                slider.onRight(nullptr);
+                length += slider.getLabel().size();
+                slider.onLeft(nullptr);
+                length += slider.getLabel().size();
+            }
+            sink = sink + static_cast<long>(length);
+        });
+
+        std::string line;
+        harness.run(std::string("slider.left_right_append.") + type, 1, moves, PageRounds, [&](){
+            std::size_t length = 0;
+            for(std::size_t i = 0; i < moves; i += 2){
+                slider.onRight(nullptr);
+                line.clear();
+                slider.appendLabel(line);
+                length += line.size();
+                slider.onLeft(nullptr);
+                line.clear();
+                slider.appendLabel(line);
+                length += line.size();
+            }
+            sink = sink + static_cast<long>(length);
+        });
+
+        // every call changes the value, so observers and the function run each time
+        mr::MenuPage page("Page");
+        auto* attached = new mr::MenuSlider<T>("Volume", T{}, T{}, step * 100, step, [](T){});
+        page.addItem(attached);
+        harness.run(std::string("slider.set_value.") + type, 1, moves, PageRounds, [&](){
+            for(std::size_t i = 0; i < moves; ++i){
+                attached->setValue(step * static_cast<T>(i % 100));
+            }
+        });
+    }
+
+    void benchRender(bench::Harness& harness){
+        constexpr int Rows = 40;
+        constexpr int Frames = 256;
+
+        mr::MenuPage page("Page");
+        fillHeap(page, PageItems);
+        mr::MenuNavigator navigator(&page);
+        navigator.setViewportSize(Rows);
+
+        NullBuffer buffer;
+        std::ostream out(&buffer);
+        mr::MenuRenderer renderer;
+        renderer.setFooter({"[w/s] move  [a/d] change  [enter] select"});
+        renderer.render(navigator, out);
+
+        harness.run("render.full_page", Rows, Frames, PageRounds, [&](){
+            for(int i = 0; i < Frames; ++i){
+                renderer.invalidate();
+                renderer.render(navigator, out);
+            }
+        });
+
+        // only the two rows the cursor left and entered are rewritten
+        harness.run("render.cursor_move", Rows, Frames, PageRounds, [&](){
+            for(int i = 0; i < Frames; ++i){
+                navigator.next();
+                renderer.render(navigator, out);
+            }
+        });
+    }
+
+    void benchDispatch(bench::Harness& harness){
+        mr::MenuPage heap("Heap");
+        mr::VariantMenuPage variant("Variant");
+        fillHeap(heap, PageItems);
+        fillVariant(variant, PageItems);
+
+        const std::pmr::vector<mr::IMenuItem*>& items = heap.getItems();
+        std::size_t calls = static_cast<std::size_t>(PageItems) * PagePasses;
+
+        harness.run("dispatch.is_end.virtual", PageItems, calls, PageRounds, [&](){
+            long ends = 0;
+            for(int pass = 0; pass < PagePasses; ++pass){
+                for(int i = 0; i < PageItems; ++i){
+                    ends += items[i]->isEnd();
+                }
+            }
+            sink = sink + ends;
+        });
+        harness.run("dispatch.is_end.variant", PageItems, calls, PageRounds, [&](){
+            long ends = 0;
+            for(int pass = 0; pass < PagePasses; ++pass){
+                for(int i = 0; i < PageItems; ++i){
+                    ends += variant.isEndAt(i);
+                }
+            }
+            sink = sink + ends;
+        });
+
+        // a step right and back leaves sliders where they were
+        harness.run("dispatch.step.virtual", PageItems, calls * 2, PageRounds, [&](){
+            for(int pass = 0; pass < PagePasses; ++pass){
+                for(int i = 0; i < PageItems; ++i){
+                    items[i]->onStep(nullptr, 1);
+                    items[i]->onStep(nullptr, -1);
+                }
+            }
+        });
+        harness.run("dispatch.step.variant", PageItems, calls * 2, PageRounds, [&](){
+            for(int pass = 0; pass < PagePasses; ++pass){
+                for(int i = 0; i < PageItems; ++i){
+                    variant.stepAt(i, nullptr, 1);
+                    variant.stepAt(i, nullptr, -1);
+                }
+            }
+        });
+
+        harness.run("dispatch.select.virtual", PageItems, calls, PageRounds, [&](){
+            for(int pass = 0; pass < PagePasses; ++pass){
+                for(int i = 0; i < PageItems; ++i){
+                    items[i]->onSelect(nullptr);
+                }
+            }
+        });
+        harness.run("dispatch.select.variant", PageItems, calls, PageRounds, [&](){
+            for(int pass = 0; pass < PagePasses; ++pass){
+                for(int i = 0; i < PageItems; ++i){
+                    variant.selectAt(i, nullptr);
+                }
+            }
+        });
+
+        mr::MenuNavigator heapNavigator(&heap);
+        mr::MenuNavigator variantNavigator(&variant);
+
+        harness.run("dispatch.navigator.virtual", PageItems, calls, PageRounds, [&](){
+            for(std::size_t i = 0; i < calls; ++i){
+                heapNavigator.next();
+                heapNavigator.right();
+            }
+        });
+        harness.run("dispatch.navigator.variant", PageItems, calls, PageRounds, [&](){
+            for(std::size_t i = 0; i < calls; ++i){
+                variantNavigator.next();
+                variantNavigator.right();
+            }
+        });
+    }
+}
+
+int main(int argc, char** argv){
+    const char* jsonPath = nullptr;
+    std::string filter;
+    bool quick = false;
+
+    for(int i = 1; i < argc; ++i){
+        if(std::strcmp(argv[i], "--json") == 0 && i + 1 < argc){
+            jsonPath = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc){
+            filter = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--quick") == 0){
+            quick = true;
+        }
+        else{
+            std::fprintf(stderr, "usage: %s [--json FILE|-] [--filter TEXT] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bench::Harness harness(filter);
+    std::fprintf(stderr, "%-36s %9s %12s %12s\n", "case (ns/op)", "items", "best", "median");
+
+    benchTree(harness, 1000, 50);
+    benchTree(harness, 100000, 5);
+    if(!quick){
+        benchTree(harness, 1000000, 3);
+    }
+    benchNavigator(harness);
+    benchSlider<int>(harness, "int", 1);
+    benchSlider<double>(harness, "double", 0.25);
+    benchRender(harness);
+    benchDispatch(harness);
+
+    if(jsonPath != nullptr){
+        bool toStdout = std::strcmp(jsonPath, "-") == 0;
+        std::FILE* out = toStdout ? stdout : std::fopen(jsonPath, "w");
+        if(out == nullptr){
+            std::fprintf(stderr, "menulib_bench: cannot open %s\n", jsonPath);
+            return 1;
+        }
+        harness.writeJson(out, MENULIB_BENCH_BUILD_TYPE);
+        if(!toStdout){
+            std::fclose(out);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include "MenuPage.hpp"
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Menu page whose items may be added and removed from other threads.
+    *
+    * Readers (navigator, renderer) pin an immutable snapshot of the item list through
+    * MenuPage::ReadGuard without taking a lock: a pin is one counter increment and one
+    * pointer load. Writers are serialized, copy the current snapshot, change the copy
+    * and publish it with a single atomic exchange.
+    *
+    * Replaced snapshots and removed items are retired and destroyed once a writer (or
+    * reclaim()) sees no reader pinned, so an item stays valid for as long as any guard
+    * that could have seen it is alive. Observers are called on the writing thread with
+    * the writer lock and MenuPage::ObserverLock held and must not modify this page.
+    *
+    * getItems() is always empty for this page, read it with MenuPage::ReadGuard,
+    * getCount() or getItem().
+    */
+    class ConcurrentMenuPage : public MenuPage{
+        private:
+
+            /**
+            * @brief Immutable item list published to readers.
+            */
+            struct Snapshot{
+                std::vector<IMenuItem*> items;
+            };
+
+            /**
+            * @brief Snapshot new readers pin, only replaced under m_writeMutex.
+            */
+            std::atomic<const Snapshot*> m_snapshot;
+
+            /**
+            * @brief Count of pins currently held on any snapshot.
+            */
+            mutable std::atomic<int> m_readers {};
+
+            /**
+            * @brief Serializes writers.
+            */
+            std::mutex m_writeMutex {};
+
+            /**
+            * @brief Snapshots replaced while readers may still hold them.
+            */
+            std::vector<const Snapshot*> m_retiredSnapshots {};
+
+            /**
+            * @brief Removed items waiting for readers to let go of them.
+            */
+            std::vector<IMenuItem*> m_retiredItems {};
+
+            /**
+            * @brief Publishes a new snapshot and retires the previous one, m_writeMutex must be held.
+            */
+            void publish(const Snapshot* next);
+
+            /**
+            * @brief Destroys retired snapshots and items if no reader is pinned, m_writeMutex must be held.
+            *
+            * @return count of items destroyed
+            */
+            std::size_t reclaimRetired();
+
+        protected:
+            const void* acquireItems() const override;
+            void releaseItems(const void* pin) const override;
+            int pinnedCount(const void* pin) const override;
+            IMenuItem* pinnedItem(const void* pin, int index) const override;
+
+        public:
+
+            /**
+            * @brief Parametric Concurrent Menu Page constructor
+            *
+            * @param title page title
+            * @param parent parent page, nullptr for the root
+            * @param resource memory resource used for the label
+            */
+            ConcurrentMenuPage(std::string_view title, MenuPage* parent = nullptr,
+                               std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+            /**
+            * @brief Destroys the page, its items and everything still retired
+            *
+            * No guard on the page may be alive.
+            */
+            ~ConcurrentMenuPage() override;
+
+            ConcurrentMenuPage(const ConcurrentMenuPage&) = delete;
+            ConcurrentMenuPage& operator=(const ConcurrentMenuPage&) = delete;
+
+            /**
+            * @brief Appends an item, callable from any thread
+            *
+            * @param item pointer to an item to append
+            */
+            void addItem(IMenuItem* item) override;
+
+            /**
+            * @brief Removes an item, callable from any thread
+            *
+            * Readers still holding the old snapshot keep using the item, it is destroyed
+            * once they are done. Removing the page a navigator is currently showing
+            * is not supported.
+            *
+            * @param item item to remove
+            * @return false if the item is not on this page
+            */
+            bool removeItem(IMenuItem* item) override;
+
+            /**
+            * @brief Destroys retired snapshots and items if no reader is pinned
+            *
+            * Writers do this on their own, call it after the last write to free
+            * memory retired while readers were active.
+            *
+            * @return count of items destroyed
+            */
+            std::size_t reclaim();
+
+            /**
+            * @brief Returns count of removed items not destroyed yet
+            */
+            std::size_t getRetiredCount();
+    };
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "MenuPage.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Menu page whose items are built by a function the first time they are needed.
+    *
+    * Building happens once, either on a worker thread through prefetch() or on the
+    * navigating thread when the page is entered. The built items are only added to
+    * the page (and announced to observers) by populate() on the navigating thread,
+    * so the builder may run in the background while the menu is in use.
+    *
+    * The page may be destroyed while its prefetch is queued or running: the
+    * destructor waits for a running builder and a queued one never starts.
+    */
+    class DeferredMenuPage : public MenuPage{
+        public:
+
+            /**
+            * @brief Function creating the page's items, in display order.
+            *
+            * The page takes ownership of the items.
+            */
+            using Builder = std::function<void(std::vector<IMenuItem*>& items)>;
+
+        private:
+
+            /**
+            * @brief Build state, shared with the prefetch tasks so they never touch the page itself.
+            */
+            struct Build{
+                Builder builder {};
+                std::once_flag done {};
+                std::atomic<bool> prefetched {};
+                std::vector<IMenuItem*> pending {};
+
+                /**
+                * @brief Runs the builder unless it already ran or the page is gone.
+                */
+                void run();
+            };
+
+            std::shared_ptr<Build> m_build {};
+            bool m_populated {};
+
+        public:
+
+            /**
+            * @brief Parametric Deferred Menu Page constructor
+            *
+            * @param title page title
+            * @param builder function creating the items
+            * @param parent parent page, nullptr for the root
+            * @param resource memory resource used for the label and the child list
+            */
+            DeferredMenuPage(std::string_view title, const Builder& builder, MenuPage* parent = nullptr,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+            /**
+            * @brief Destroys the page, including items built but never added
+            *
+            * Waits for a builder running on a worker, prefetch tasks still queued do nothing.
+            */
+            ~DeferredMenuPage() override;
+
+            /**
+            * @brief Runs the builder unless it already ran, callable from any thread
+            *
+            * Concurrent callers wait for the first one. If the builder throws,
+            * the next call runs it again.
+            */
+            void prefetch() override;
+
+            bool isPrefetched() const override;
+
+            /**
+            * @brief Returns a task running the builder, safe to run after the page is destroyed
+            */
+            std::function<void()> prefetchTask() override;
+
+            /**
+            * @brief Builds the items if needed and adds them to the page
+            */
+            void populate() override;
+
+            /**
+            * @brief Tells whether the built items were added to the page
+            */
+            bool isPopulated() const;
+    };
+}
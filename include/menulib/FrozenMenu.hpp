@@ -0,0 +1,180 @@
+#pragma once
+#include "IMenuItem.hpp"
+#include "MenuPage.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Read-mostly, flattened copy of a built menu tree.
+    *
+    * FrozenMenu lays a MenuPage tree out as a structure of arrays: node kinds,
+    * parent links, contiguous child ranges, offsets into a single label blob and
+    * numeric value slots. Nodes are stored breadth-first so the children of every
+    * page sit next to each other, and walking or rendering the menu touches only
+    * these arrays - no pointer chasing and no virtual calls.
+    *
+    * Actions (selecting an option or toggle, moving a slider) are forwarded to the
+    * original item, after which the node's label and value slot are refreshed.
+    * The source tree must therefore outlive the frozen menu. Structural changes made
+    * to the source after freezing are not reflected; freeze the tree again instead.
+    * Removing an item destroys it while its node still points to it, so the frozen
+    * menu must not be used again after a removal. Lazy pages and ConcurrentMenuPage,
+    * whose items change behind the frozen copy, cannot be frozen.
+    */
+    class FrozenMenu{
+        public:
+
+            /**
+            * @brief Node index marking "no node" (e.g. the parent of the root).
+            */
+            static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+        private:
+
+            std::vector<ItemKind> m_kinds {};
+            std::vector<std::uint32_t> m_parents {};
+            std::vector<std::uint32_t> m_firstChild {};
+            std::vector<std::uint32_t> m_childCount {};
+            std::vector<std::uint32_t> m_labelOffset {};
+            std::vector<std::uint32_t> m_labelLength {};
+
+            /**
+            * @brief Toggle state (0/1) or slider value per node, 0 for other kinds.
+            */
+            std::vector<double> m_values {};
+
+            /**
+            * @brief All labels back to back.
+            *
+            * Labels that change are appended at the end; the blob is compacted
+            * once the stale part outgrows the live part.
+            */
+            std::string m_labels {};
+
+            /**
+            * @brief Bytes of m_labels no longer referenced by any node.
+            */
+            std::size_t m_staleBytes {};
+
+            /**
+            * @brief Original items, only touched when an action is forwarded.
+            */
+            std::vector<IMenuItem*> m_sources {};
+
+            /**
+            * @brief Reverse lookup from original page to node index.
+            */
+            std::unordered_map<const IMenuItem*, std::uint32_t> m_pageNodes {};
+
+            /**
+            * @brief Stores a node's label at the end of the blob.
+            */
+            void storeLabel(std::uint32_t node, std::string_view label);
+
+            /**
+            * @brief Reads the value slot from the original item.
+            */
+            static double readValue(const IMenuItem* item);
+
+            /**
+            * @brief Rewrites the blob without stale labels.
+            */
+            void compactLabels();
+
+        public:
+
+            /**
+            * @brief Freezes a menu tree
+            *
+            * @param root pointer to the root menu page
+            * @throws std::invalid_argument if the tree holds a lazy page or a ConcurrentMenuPage
+            */
+            explicit FrozenMenu(MenuPage* root);
+
+            /**
+            * @brief Returns count of nodes (the root included)
+            */
+            std::uint32_t getNodeCount() const;
+
+            /**
+            * @brief Returns the kind of a node
+            */
+            ItemKind getKind(std::uint32_t node) const;
+
+            /**
+            * @brief Returns the parent node, npos for the root
+            */
+            std::uint32_t getParent(std::uint32_t node) const;
+
+            /**
+            * @brief Returns count of children of a page node (0 for leaves)
+            */
+            std::uint32_t getChildCount(std::uint32_t node) const;
+
+            /**
+            * @brief Returns node index of the n-th child of a page node
+            */
+            std::uint32_t getChild(std::uint32_t node, std::uint32_t index) const;
+
+            /**
+            * @brief Returns the display label of a node
+            *
+            * @return view into the label blob, valid until the next action or refresh
+            */
+            std::string_view getLabel(std::uint32_t node) const;
+
+            /**
+            * @brief Returns the value slot of a node
+            *
+            * @return 0/1 for toggles, current value for sliders, 0 otherwise
+            */
+            double getValue(std::uint32_t node) const;
+
+            /**
+            * @brief Returns the original item a node was built from
+            */
+            IMenuItem* getSource(std::uint32_t node) const;
+
+            /**
+            * @brief Finds the node of an original page
+            *
+            * @return node index or npos if the page is not part of the frozen tree
+            */
+            std::uint32_t findPage(const MenuPage* page) const;
+
+            /**
+            * @brief Forwards select to the original item and refreshes the node
+            */
+            void select(std::uint32_t node, MenuNavigator* navigator);
+
+            /**
+            * @brief Forwards left to the original item and refreshes the node
+            */
+            void left(std::uint32_t node, MenuNavigator* navigator);
+
+            /**
+            * @brief Forwards right to the original item and refreshes the node
+            */
+            void right(std::uint32_t node, MenuNavigator* navigator);
+
+            /**
+            * @brief Forwards several left/right moves to the original item and refreshes the node
+            */
+            void step(std::uint32_t node, MenuNavigator* navigator, int steps);
+
+            /**
+            * @brief Re-reads label and value of one node from its original item
+            */
+            void refresh(std::uint32_t node);
+
+            /**
+            * @brief Re-reads labels and values of all nodes
+            */
+            void refresh();
+    };
+}
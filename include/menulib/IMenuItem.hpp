@@ -1,5 +1,10 @@
 #pragma once
+#include "LabelPool.hpp"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 namespace mr{
 
@@ -8,6 +13,36 @@ namespace mr{
     */
     class MenuNavigator;
 
+    /**
+    * @brief Forward declaration of the arena that can own menu items.
+    */
+    class MenuArena;
+
+    /**
+    * @brief Forward declaration of the page type holding items.
+    */
+    class MenuPage;
+
+    /**
+    * @brief Built-in item categories.
+    *
+    * Lets code that flattens, stores or inspects a menu tree (e.g. FrozenMenu)
+    * tell the item types apart without dynamic_cast. User-defined items report Custom.
+    */
+    enum class ItemKind : std::uint8_t{
+        Page,
+        Option,
+        Toggle,
+        Slider,
+        Custom
+    };
+
+    /**
+    * @brief Identifier of an item, unique for the life of the process; 0 is never assigned.
+    *
+    * 64 bits wide, so the counter does not wrap even at billions of items per second.
+    */
+    using ItemId = std::uint64_t;
 
     /**
     * @brief Interface for all menu item types.
@@ -16,12 +51,42 @@ namespace mr{
     * that can be displayed and selected by the user.
     */
     class IMenuItem{
+        friend class MenuArena;
+        friend class MenuPage;
+
         private:
 
             /**
-            * @brief Display label of the menu item.
+            * @brief Pool the label is interned in, chosen by the memory resource (see LabelPool::of()).
+            */
+            LabelPool* m_labels;
+
+            /**
+            * @brief Display label of the menu item, interned in m_labels.
+            *
+            * Stateful items decorate it with their value in appendLabel() and getLabel().
+            */
+            std::string_view m_label;
+
+            /**
+            * @brief Memory resource the item was constructed with.
+            */
+            std::pmr::memory_resource* m_resource;
+
+            /**
+            * @brief Set by MenuArena for items whose storage and lifetime it manages.
+            */
+            bool m_arenaAllocated {};
+
+            /**
+            * @brief Identifier assigned at construction, kept through relabelling and moves between pages.
             */
-            std::string m_label {};
+            ItemId m_id;
+
+            /**
+            * @brief Page this item was added to, set by MenuPage::addItem().
+            */
+            MenuPage* m_owner {};
 
         protected:
 
@@ -30,23 +95,93 @@ namespace mr{
             *
             * Protected to prevent directly creating an interface instance without specified type.
             *
-            * @param label text displayed for this menu item.
+            * @param label text displayed for this menu item, interned in the resource's LabelPool.
+            * @param resource memory resource for the storage of derived items.
+            */
+            IMenuItem(std::string_view label, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : m_labels(&LabelPool::of(resource)), m_label(m_labels->intern(label)), m_resource(resource), m_id(nextId()) {}
+
+            IMenuItem(const IMenuItem&) = delete;
+            IMenuItem& operator=(const IMenuItem&) = delete;
+
+            /**
+            * @brief Composes appendLabel() into a buffer created on first use.
+            *
+            * Backs getLabel() of items whose display label is decorated, so only
+            * callers of getLabel() pay for a stored copy; renderers use appendLabel().
+            *
+            * @param buffer item's buffer, created here if empty
+            * @return view of the buffer, valid until the next call
+            */
+            std::string_view composeLabel(std::unique_ptr<std::string>& buffer) const
+            {
+                if(!buffer){
+                    buffer = std::make_unique<std::string>();
+                }
+                buffer->clear();
+                appendLabel(*buffer);
+                return *buffer;
+            }
+
+            /**
+            * @brief Returns a new item identifier, safe to call from any thread.
+            */
+            static ItemId nextId();
+
+            /**
+            * @brief Tells observers of the pages above that the item's value changed.
+            *
+            * Called by stateful items (toggles, sliders) on the thread that changed the value.
+            */
+            void notifyValueChanged();
+
+            /**
+            * @brief Tells observers of the pages above that the displayed label changed.
+            *
+            * For labels composed by appendLabel(), e.g. with a status suffix; setLabel() notifies itself.
             */
-            IMenuItem(const std::string& label) : m_label(label) {}
+            void notifyLabelChanged();
 
         public:
 
             /**
-            * @brief Virtual destructor.
+            * @brief Virtual destructor, releases the interned label.
             */
-            virtual ~IMenuItem() = default;
+            virtual ~IMenuItem()
+            {
+                m_labels->release(m_label);
+            }
 
             /**
             * @brief Returns the menu item's display label.
             *
             * @return The menu item's label
             */
-            virtual const std::string& getLabel() const
+            virtual std::string_view getLabel() const
+            {
+                return m_label;
+            }
+
+            /**
+            * @brief Appends the display label to a line being rendered.
+            *
+            * Stateful items compose their decoration here from the current value,
+            * without storing the decorated label. The default appends getLabel().
+            *
+            * @param out line to append to
+            */
+            virtual void appendLabel(std::string& out) const
+            {
+                std::string_view label = getLabel();
+                out.append(label.data(), label.size());
+            }
+
+            /**
+            * @brief Returns the label without any decoration added by the item type.
+            *
+            * @return The label as set in the constructor or by setLabel()
+            */
+            std::string_view getBaseLabel() const
             {
                 return m_label;
             }
@@ -59,6 +194,16 @@ namespace mr{
             */
             virtual bool isEnd() const = 0;
 
+            /**
+            * @brief Returns the category of this item.
+            *
+            * @return ItemKind::Custom unless overridden by a built-in item type
+            */
+            virtual ItemKind getKind() const
+            {
+                return ItemKind::Custom;
+            }
+
             /**
             * @brief Called when the item is selected.
             *
@@ -72,15 +217,11 @@ namespace mr{
             /**
             * @brief Sets the menu item's display label.
             *
+            * Observers of the pages above the item are notified.
+            *
             * @param label New label text
             */
-            virtual void setLabel(const std::string& label)
-            {
-                if(!label.empty())
-                {
-                    m_label = label;
-                }
-            }
+            virtual void setLabel(std::string_view label);
 
             /**
             * @brief Blank function for moving slider control to the left
@@ -95,5 +236,66 @@ namespace mr{
             * @param navigator Pointer to the menu navigator controlling the current menu.
             */
             virtual void onRight(MenuNavigator* navigator){};
+
+            /**
+            * @brief Applies several left/right moves at once
+            *
+            * The default implementation calls onLeft() or onRight() once per step,
+            * items that can do better (sliders) override it.
+            *
+            * @param navigator Pointer to the menu navigator controlling the current menu.
+            * @param steps count of moves, negative to the left, positive to the right
+            */
+            virtual void onStep(MenuNavigator* navigator, int steps)
+            {
+                for(; steps < 0; ++steps){
+                    onLeft(navigator);
+                }
+                for(; steps > 0; --steps){
+                    onRight(navigator);
+                }
+            }
+
+            /**
+            * @brief Tells whether the item lives inside a MenuArena.
+            *
+            * Arena items are destroyed by their arena, never by the page holding them.
+            *
+            * @return true if the item was created by MenuArena::create()
+            */
+            bool isArenaAllocated() const
+            {
+                return m_arenaAllocated;
+            }
+
+            /**
+            * @brief Returns the item's identifier.
+            *
+            * @return identifier assigned at construction, never 0
+            */
+            ItemId getId() const
+            {
+                return m_id;
+            }
+
+            /**
+            * @brief Returns the page this item was added to.
+            *
+            * @return owning page, nullptr if the item is not part of a page
+            */
+            MenuPage* getOwner() const
+            {
+                return m_owner;
+            }
+
+            /**
+            * @brief Returns the memory resource backing this item's storage.
+            *
+            * @return memory resource passed at construction
+            */
+            std::pmr::memory_resource* getResource() const
+            {
+                return m_resource;
+            }
     };
 }
@@ -0,0 +1,61 @@
+#pragma once
+
+namespace mr{
+
+    class IMenuItem;
+    class MenuPage;
+
+    /**
+    * @brief Interface for code that keeps derived data in sync with a menu tree.
+    *
+    * Observers are attached to a MenuPage and are told about changes made anywhere
+    * in the subtree below it, so an observer attached to the root sees the whole menu.
+    * Notifications are delivered synchronously on the thread making the change, which
+    * may be any thread for ConcurrentMenuPage and for values. They are delivered one
+    * at a time under MenuPage::ObserverLock, so an observer is never called
+    * concurrently with itself; reads of its state from other threads must be locked.
+    */
+    class IMenuObserver{
+        public:
+
+            /**
+            * @brief Virtual destructor.
+            */
+            virtual ~IMenuObserver() = default;
+
+            /**
+            * @brief Called after an item was appended to a page.
+            *
+            * If the item is a page, its own children were not announced before
+            * and have to be inspected by the observer.
+            *
+            * @param page page the item was added to
+            * @param item added item
+            */
+            virtual void onItemAdded(MenuPage* page, IMenuItem* item){};
+
+            /**
+            * @brief Called after an item was taken off a page, before it is destroyed.
+            *
+            * If the item is a page, its children go with it.
+            *
+            * @param page page the item was removed from
+            * @param item removed item
+            */
+            virtual void onItemRemoved(MenuPage* page, IMenuItem* item){};
+
+            /**
+            * @brief Called after an item's label was changed with setLabel().
+            *
+            * @param item item whose label changed
+            */
+            virtual void onLabelChanged(IMenuItem* item){};
+
+            /**
+            * @brief Called after a toggle or slider value changed.
+            *
+            * @param item item whose value changed
+            */
+            virtual void onValueChanged(IMenuItem* item){};
+    };
+}
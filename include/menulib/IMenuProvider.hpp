@@ -0,0 +1,37 @@
+#pragma once
+
+namespace mr{
+
+    class IMenuItem;
+
+    /**
+    * @brief Interface for data sources backing a ProviderMenuPage.
+    *
+    * The provider reports how many children the page has and builds a child
+    * when it is first looked at, so nothing is created for rows nobody sees.
+    */
+    class IMenuProvider{
+        public:
+
+            /**
+            * @brief Virtual destructor.
+            */
+            virtual ~IMenuProvider() = default;
+
+            /**
+            * @brief Returns count of children, may change between calls.
+            */
+            virtual int getCount() const = 0;
+
+            /**
+            * @brief Creates the child at an index.
+            *
+            * The page takes ownership of the returned item and deletes it once it
+            * falls out of the cache, unless it was allocated in a MenuArena.
+            *
+            * @param index child index, below getCount()
+            * @return newly created item, never nullptr
+            */
+            virtual IMenuItem* createItem(int index) = 0;
+    };
+}
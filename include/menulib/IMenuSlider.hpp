@@ -0,0 +1,73 @@
+#pragma once
+#include "IMenuItem.hpp"
+#include <memory_resource>
+#include <string_view>
+
+namespace mr{
+
+    /**
+    * @brief Type-erased interface of MenuSlider.
+    *
+    * MenuSlider is a template, so code that has to handle sliders of any value type
+    * (flattening, saving, comparing state) reads and writes them through this interface
+    * with the value converted to double.
+    */
+    class IMenuSlider : public IMenuItem{
+        protected:
+
+            /**
+            * @brief Constructs a slider item with given label.
+            *
+            * @param label text displayed for this menu item.
+            * @param resource memory resource used for the label storage.
+            */
+            IMenuSlider(std::string_view label, std::pmr::memory_resource* resource)
+                : IMenuItem(label, resource) {}
+
+        public:
+
+            /**
+            * @brief Returns the category of this item.
+            *
+            * @return ItemKind::Slider
+            */
+            ItemKind getKind() const override
+            {
+                return ItemKind::Slider;
+            }
+
+            /**
+            * @brief Returns current value converted to double
+            */
+            virtual double getNumericValue() const = 0;
+
+            /**
+            * @brief Returns minimum value converted to double
+            */
+            virtual double getNumericMin() const = 0;
+
+            /**
+            * @brief Returns maximum value converted to double
+            */
+            virtual double getNumericMax() const = 0;
+
+            /**
+            * @brief Returns step converted to double
+            */
+            virtual double getNumericStep() const = 0;
+
+            /**
+            * @brief Sets current value from a double, converting it to the slider's type
+            *
+            * @param value new value, clamped to the slider bounds before the conversion; NaN is ignored
+            */
+            virtual void setNumericValue(double value) = 0;
+
+            /**
+            * @brief Tells whether the slider holds an integral type
+            *
+            * @return true for integer sliders, false for floating point ones
+            */
+            virtual bool isIntegral() const = 0;
+    };
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+* @brief Inline storage of item callbacks (MenuCallback), in bytes.
+*
+* Set it with the MENULIB_CALLBACK_CAPACITY CMake cache variable to fit larger
+* captures, so the library and its users agree. The items' layout depends on
+* it, defining it in user code only would break the one definition rule.
+*/
+#ifndef MENULIB_CALLBACK_CAPACITY
+#define MENULIB_CALLBACK_CAPACITY (4 * sizeof(void*))
+#endif
+
+namespace mr{
+
+    template <typename Signature, std::size_t Capacity>
+    class InplaceFunction;
+
+    namespace detail{
+
+        template <typename F, typename = void>
+        struct HasBoolOperator : std::false_type{};
+
+        template <typename F>
+        struct HasBoolOperator<F, std::void_t<decltype(&F::operator bool)>> : std::true_type{};
+
+        /**
+        * @brief Callables which may be empty, an empty one leaves the InplaceFunction empty.
+        *
+        * Only pointers and classes with operator bool (std::function, InplaceFunction)
+        * are tested. A function passed by reference is never null and testing it
+        * would warn (-Waddress, -Wnonnull-compare), so F is the type as passed,
+        * before decay.
+        */
+        template <typename F>
+        struct IsNullable : std::bool_constant<std::is_pointer<F>::value || std::is_member_pointer<F>::value
+                                               || HasBoolOperator<F>::value>{};
+    }
+
+    /**
+    * @brief Move-only callable kept entirely inside the object.
+    *
+    * Works like std::function but never allocates: the callable is stored in
+    * Capacity bytes of inline storage, and one that does not fit is a compile
+    * error instead of a heap allocation. Calling it is one indirect call, with
+    * no further indirection to reach the callable.
+    *
+    * @tparam Signature function type, e.g. void(int)
+    * @tparam Capacity inline storage in bytes
+    */
+    template <typename R, typename... Args, std::size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>{
+        private:
+
+            /**
+            * @brief Operations of the stored callable's type.
+            */
+            struct Operations{
+                R (*invoke)(void* storage, Args&&... args);
+                void (*move)(void* destination, void* source);
+                void (*destroy)(void* storage);
+            };
+
+            template <typename F>
+            static R invokeStored(void* storage, Args&&... args){
+                return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+            }
+
+            template <typename F>
+            static void moveStored(void* destination, void* source){
+                ::new (destination) F(std::move(*static_cast<F*>(source)));
+                static_cast<F*>(source)->~F();
+            }
+
+            template <typename F>
+            static void destroyStored(void* storage){
+                static_cast<F*>(storage)->~F();
+            }
+
+            template <typename F>
+            static constexpr Operations s_operations{&invokeStored<F>, &moveStored<F>, &destroyStored<F>};
+
+            alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+
+            /**
+            * @brief Operations of the stored callable, nullptr when empty.
+            */
+            const Operations* m_operations {};
+
+            void moveFrom(InplaceFunction& other) noexcept{
+                if(other.m_operations){
+                    other.m_operations->move(m_storage, other.m_storage);
+                    m_operations = other.m_operations;
+                    other.m_operations = nullptr;
+                }
+            }
+
+        public:
+
+            /**
+            * @brief Creates an empty function
+            */
+            InplaceFunction() noexcept = default;
+
+            /**
+            * @brief Creates an empty function
+            */
+            InplaceFunction(std::nullptr_t) noexcept {}
+
+            /**
+            * @brief Stores a callable
+            *
+            * Null function pointers and empty std::function objects give an empty function.
+            *
+            * @param callable callable taking Args and returning R, moved or copied into the storage
+            */
+            template <typename F, typename D = std::decay_t<F>,
+                      typename = std::enable_if_t<!std::is_same<D, InplaceFunction>::value
+                                                  && std::is_invocable_r<R, D&, Args...>::value>>
+            InplaceFunction(F&& callable){
+                static_assert(sizeof(D) <= Capacity,
+                              "InplaceFunction: callable does not fit the inline storage, capture less or raise the capacity");
+                static_assert(alignof(D) <= alignof(std::max_align_t),
+                              "InplaceFunction: callable is over-aligned");
+                static_assert(std::is_nothrow_move_constructible<D>::value,
+                              "InplaceFunction: callable must be nothrow move constructible");
+
+                if constexpr (detail::IsNullable<std::remove_cv_t<std::remove_reference_t<F>>>::value){
+                    if(!callable){
+                        return;
+                    }
+                }
+                ::new (static_cast<void*>(m_storage)) D(std::forward<F>(callable));
+                m_operations = &s_operations<D>;
+            }
+
+            InplaceFunction(InplaceFunction&& other) noexcept{
+                moveFrom(other);
+            }
+
+            InplaceFunction& operator=(InplaceFunction&& other) noexcept{
+                if(this != &other){
+                    reset();
+                    moveFrom(other);
+                }
+                return *this;
+            }
+
+            InplaceFunction& operator=(std::nullptr_t) noexcept{
+                reset();
+                return *this;
+            }
+
+            InplaceFunction(const InplaceFunction&) = delete;
+            InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+            ~InplaceFunction(){
+                reset();
+            }
+
+            /**
+            * @brief Destroys the stored callable, leaving the function empty
+            */
+            void reset() noexcept{
+                if(m_operations){
+                    m_operations->destroy(m_storage);
+                    m_operations = nullptr;
+                }
+            }
+
+            /**
+            * @brief Tells whether a callable is stored
+            */
+            explicit operator bool() const noexcept{
+                return m_operations != nullptr;
+            }
+
+            /**
+            * @brief Calls the stored callable
+            *
+            * @throws std::bad_function_call if the function is empty
+            */
+            R operator()(Args... args) const{
+                if(!m_operations){
+                    throw std::bad_function_call();
+                }
+                return m_operations->invoke(m_storage, std::forward<Args>(args)...);
+            }
+    };
+
+    /**
+    * @brief Callback type of the built-in items, see MENULIB_CALLBACK_CAPACITY.
+    */
+    template <typename Signature>
+    using MenuCallback = InplaceFunction<Signature, MENULIB_CALLBACK_CAPACITY>;
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace mr{
+
+    /**
+    * @brief Reference-counted store of label text, each distinct label kept once.
+    *
+    * Items intern their label here and keep only a view of the pooled text, so
+    * "Back", "Enabled" or "Volume" repeated across submenus cost one copy. Text is
+    * released when its last item goes or changes its label, so pages creating
+    * items on demand do not make the pool grow without bound.
+    *
+    * Interning and releasing take a lock and may be called from any thread;
+    * reading an interned view needs no lock.
+    *
+    * Items intern their label in the pool of the memory resource they are
+    * constructed with (see of()): a resource implementing LabelPoolOwner, such as
+    * a MenuArena's, brings a pool of its own, so separate trees do not share a
+    * lock and the text lives in the tree's storage. Any other resource uses shared().
+    */
+    class LabelPool{
+        private:
+            struct Entry{
+                std::size_t refs {};
+            };
+
+            mutable std::mutex m_mutex {};
+
+            /**
+            * @brief Backs the label text and the map nodes, only touched under m_mutex.
+            */
+            std::pmr::unsynchronized_pool_resource m_storage {};
+
+            /**
+            * @brief Entries keyed by views of their own text.
+            */
+            std::pmr::unordered_map<std::string_view, Entry> m_entries {&m_storage};
+
+            std::size_t m_bytes {};
+
+        public:
+
+            /**
+            * @brief Parametric Label Pool constructor
+            *
+            * @param upstream memory resource the label text is carved from, must outlive the pool
+            */
+            explicit LabelPool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+            /**
+            * @brief Frees all text, views handed out become invalid
+            */
+            ~LabelPool() = default;
+
+            LabelPool(const LabelPool&) = delete;
+            LabelPool& operator=(const LabelPool&) = delete;
+
+            /**
+            * @brief Returns the pool used by all menu items
+            *
+            * Never destroyed, so items in static storage can release their labels at exit.
+            */
+            static LabelPool& shared();
+
+            /**
+            * @brief Returns the pool of items constructed with a memory resource
+            *
+            * @param resource memory resource of an item
+            * @return the resource's own pool if it implements LabelPoolOwner, shared() otherwise
+            */
+            static LabelPool& of(std::pmr::memory_resource* resource);
+
+            /**
+            * @brief Stores a label or takes another reference to it
+            *
+            * @param label text to intern
+            * @return view of the pooled text, valid until the matching release(); empty for an empty label
+            */
+            std::string_view intern(std::string_view label);
+
+            /**
+            * @brief Drops a reference taken by intern()
+            *
+            * @param label view returned by intern()
+            */
+            void release(std::string_view label);
+
+            /**
+            * @brief Returns count of distinct labels held
+            */
+            std::size_t getCount() const;
+
+            /**
+            * @brief Returns bytes of label text held
+            */
+            std::size_t getBytes() const;
+    };
+
+    /**
+    * @brief Memory resource bringing its own LabelPool for the items constructed with it.
+    *
+    * Mixed into a std::pmr::memory_resource, e.g. by MenuArena. The pool must outlive
+    * every item constructed with the resource and stay at the same address.
+    */
+    class LabelPoolOwner{
+        public:
+
+            /**
+            * @brief Returns the pool the resource's items intern their labels in
+            */
+            virtual LabelPool& getLabelPool() = 0;
+
+            LabelPoolOwner(const LabelPoolOwner&) = delete;
+            LabelPoolOwner& operator=(const LabelPoolOwner&) = delete;
+
+        protected:
+
+            /**
+            * @brief Registers the owner, invalidating the lookups LabelPool::of() caches per thread
+            */
+            LabelPoolOwner();
+
+            /**
+            * @brief Unregisters the owner, invalidating the lookups LabelPool::of() caches per thread
+            */
+            ~LabelPoolOwner();
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mr{
+
+    /**
+    * @brief Callbacks looked up by name when a menu is loaded from a file.
+    *
+    * Menu files only store callback names, the registry maps them back to
+    * functions. Options, toggles and sliders have separate namespaces.
+    *
+    * Loaded items call the registered functions through a pointer, so their
+    * callbacks fit the inline MenuCallback storage and never copy a
+    * std::function. The registry must outlive the items; registering more
+    * names does not move the functions already registered.
+    */
+    class MenuActionRegistry{
+        private:
+            std::unordered_map<std::string, std::function<void()>> m_actions {};
+            std::unordered_map<std::string, std::function<void(bool)>> m_toggles {};
+            std::unordered_map<std::string, std::function<void(double)>> m_sliders {};
+
+        public:
+
+            /**
+            * @brief Registers an option action
+            *
+            * @param name name used in menu files
+            * @param action function run when the option is selected
+            * @throws std::invalid_argument if the name is empty or taken, or the function is empty
+            */
+            void addAction(std::string_view name, const std::function<void()>& action);
+
+            /**
+            * @brief Registers a toggle callback
+            *
+            * @param name name used in menu files
+            * @param callback function receiving the new state
+            * @throws std::invalid_argument if the name is empty or taken, or the function is empty
+            */
+            void addToggle(std::string_view name, const std::function<void(bool)>& callback);
+
+            /**
+            * @brief Registers a slider callback
+            *
+            * Integral sliders pass their value converted to double.
+            *
+            * @param name name used in menu files
+            * @param callback function receiving the new value
+            * @throws std::invalid_argument if the name is empty or taken, or the function is empty
+            */
+            void addSlider(std::string_view name, const std::function<void(double)>& callback);
+
+            /**
+            * @brief Returns an option action, nullptr if the name is not registered
+            */
+            const std::function<void()>* findAction(std::string_view name) const;
+
+            /**
+            * @brief Returns a toggle callback, nullptr if the name is not registered
+            */
+            const std::function<void(bool)>* findToggle(std::string_view name) const;
+
+            /**
+            * @brief Returns a slider callback, nullptr if the name is not registered
+            */
+            const std::function<void(double)>* findSlider(std::string_view name) const;
+    };
+}
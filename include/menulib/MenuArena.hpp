@@ -0,0 +1,157 @@
+#pragma once
+#include "IMenuItem.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mr{
+
+    /**
+    * @brief Block allocator owning a whole menu tree.
+    *
+    * MenuArena carves items and the pages' child vectors out of a few large blocks
+    * instead of allocating every node separately. Labels are interned in a LabelPool
+    * owned by the arena and carved from the same blocks, so building a tree takes no
+    * process-wide lock; any item constructed with getResource() uses it. Every item created
+    * through create() is destroyed by the arena (in creation order) and the memory is
+    * returned in one step when the arena is released or destroyed.
+    *
+    * Items are constructed with the arena's memory resource appended as the last
+    * constructor argument, so root pages have to pass their parent (nullptr) explicitly:
+    * @code
+    * mr::MenuArena arena;
+    * mr::MenuPage* root = arena.create<mr::MenuPage>("Main Menu", nullptr);
+    * root->addItem(arena.create<mr::MenuOption>("Start Game", startGame));
+    * @endcode
+    *
+    * The arena must outlive every navigator or heap-allocated page referencing its items.
+    */
+    class MenuArena{
+        private:
+
+            /**
+            * @brief Link of the destruction list, allocated from the arena itself.
+            */
+            struct Node{
+                Node* next;
+                IMenuItem* item;
+            };
+
+            /**
+            * @brief Block allocator bringing the arena's label pool to the items.
+            */
+            class Resource : public std::pmr::monotonic_buffer_resource, public LabelPoolOwner{
+                public:
+                    /**
+                    * @brief Labels of the arena's items, recreated when the blocks are released.
+                    */
+                    std::optional<LabelPool> m_labels {};
+
+                    explicit Resource(std::size_t initialBlockSize);
+
+                    LabelPool& getLabelPool() override;
+            };
+
+            /**
+            * @brief Upstream block allocator for all arena storage.
+            */
+            Resource m_resource;
+
+            /**
+            * @brief First created item (destroyed first).
+            */
+            Node* m_head {};
+
+            /**
+            * @brief Last created item, used for O(1) appends.
+            */
+            Node* m_tail {};
+
+            /**
+            * @brief Number of items currently owned by the arena.
+            */
+            std::size_t m_count {};
+
+            /**
+            * @brief Runs destructors of all owned items in creation order.
+            *
+            * Pages are created before their children, so a page never
+            * touches a child that has already been destroyed.
+            */
+            void destroyAll();
+
+        public:
+
+            /**
+            * @brief Creates an arena.
+            *
+            * @param initialBlockSize size in bytes of the first block requested from the heap.
+            */
+            explicit MenuArena(std::size_t initialBlockSize = 64 * 1024);
+
+            /**
+            * @brief Destroys all items and releases the arena blocks.
+            */
+            ~MenuArena();
+
+            MenuArena(const MenuArena&) = delete;
+            MenuArena& operator=(const MenuArena&) = delete;
+
+            /**
+            * @brief Constructs a menu item inside the arena.
+            *
+            * @tparam T concrete IMenuItem type
+            * @param args constructor arguments, without the trailing memory resource
+            * @return pointer to the item, owned by the arena
+            */
+            template <typename T, typename... Args>
+            T* create(Args&&... args){
+                static_assert(std::is_base_of<IMenuItem, T>::value, "MenuArena: can only create menu items.");
+                static_assert(std::is_constructible<T, Args&&..., std::pmr::memory_resource*>::value,
+                              "MenuArena: item type must accept a trailing std::pmr::memory_resource*.");
+
+                // link is allocated first so a failed allocation cannot leak a constructed item
+                void* link = m_resource.allocate(sizeof(Node), alignof(Node));
+                void* storage = m_resource.allocate(sizeof(T), alignof(T));
+
+                T* item = new (storage) T(std::forward<Args>(args)..., &m_resource);
+                item->m_arenaAllocated = true;
+
+                Node* node = new (link) Node{nullptr, item};
+                if(m_tail){
+                    m_tail->next = node;
+                }
+                else{
+                    m_head = node;
+                }
+                m_tail = node;
+                ++m_count;
+
+                return item;
+            }
+
+            /**
+            * @brief Returns the memory resource for user allocations tied to the arena lifetime.
+            *
+            * @return arena memory resource
+            */
+            std::pmr::memory_resource* getResource();
+
+            /**
+            * @brief Returns count of items owned by the arena
+            *
+            * @return count of items
+            */
+            std::size_t getCount() const;
+
+            /**
+            * @brief Destroys all items and returns the blocks to the heap.
+            *
+            * The arena can be reused afterwards.
+            */
+            void release();
+    };
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include "MenuPage.hpp"
+#include "MenuActionRegistry.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mr{
+
+    /**
+    * @brief Menu tree stored in a versioned binary file and memory-mapped for reading.
+    *
+    * The file holds a header, one fixed-size record per item in breadth-first
+    * order (children of a page are contiguous), slider ranges and a blob of
+    * labels and callback names. Loading maps the file and checks the header and
+    * the records of the root's children, so it takes time proportional to the
+    * root's child count, not to the file size. The records of any other page's
+    * children are checked when the page is built and its IMenuItem objects are
+    * only created when a reader touches them. getLabel() reads labels in place;
+    * a created item copies its label into the LabelPool like any other item.
+    * Created children stay alive until the MenuBinary is destroyed, so pages are
+    * not lazy (MenuPage::isLazy()) and the tree works with MenuSettings,
+    * MenuIndex, MenuSearchIndex and FrozenMenu, which build every child they visit.
+    *
+    * Callbacks are saved by name and bound through a MenuActionRegistry on load.
+    * Names missing from the registry leave the item without a callback.
+    */
+    class MenuBinary{
+        public:
+
+            /**
+            * @brief Current file format version.
+            */
+            static constexpr std::uint32_t Version = 1;
+
+            /**
+            * @brief Callback names of saved items, items without a name have no callback.
+            */
+            using ActionNames = std::unordered_map<const IMenuItem*, std::string>;
+
+        private:
+            struct NodeRecord;
+            struct SliderRecord;
+            class Children;
+            class Page;
+
+            const unsigned char* m_data {};
+            std::size_t m_size {};
+            const NodeRecord* m_nodes {};
+            const SliderRecord* m_sliders {};
+            const char* m_strings {};
+            std::uint32_t m_nodeCount {};
+            std::uint32_t m_sliderCount {};
+            std::uint64_t m_stringBytes {};
+            const MenuActionRegistry* m_registry {};
+            Page* m_root {};
+
+            /**
+            * @brief Checks the header of the mapped file, throws std::runtime_error if it is malformed.
+            */
+            void validate();
+
+            /**
+            * @brief Checks the records of a page's children before the page is built.
+            */
+            void checkPage(std::uint32_t node) const;
+
+            /**
+            * @brief Creates the item of a node.
+            */
+            IMenuItem* createItem(std::uint32_t node);
+
+            std::string_view stringAt(std::uint32_t offset, std::uint32_t length) const;
+            void unmap();
+
+        public:
+
+            /**
+            * @brief Writes a menu tree to a file
+            *
+            * @param root root page of the tree
+            * @param path file to write
+            * @param actions callback names of the items
+            * @throws std::invalid_argument if the tree holds custom items
+            * @throws std::runtime_error if the file cannot be written
+            */
+            static void save(const MenuPage& root, const std::string& path, const ActionNames& actions = {});
+
+            /**
+            * @brief Maps a menu file
+            *
+            * @param path file to read
+            * @param registry callbacks bound by name, nullptr to load without callbacks,
+            *                 must outlive the MenuBinary
+            * @throws std::runtime_error if the file cannot be mapped, its header or the root's
+            *         children are malformed, other pages with malformed children throw when they are built
+            */
+            explicit MenuBinary(const std::string& path, const MenuActionRegistry* registry = nullptr);
+
+            /**
+            * @brief Destroys the created items and unmaps the file
+            */
+            ~MenuBinary();
+
+            MenuBinary(const MenuBinary&) = delete;
+            MenuBinary& operator=(const MenuBinary&) = delete;
+
+            /**
+            * @brief Returns the root page, created on load
+            */
+            MenuPage* getRoot() const;
+
+            /**
+            * @brief Returns count of items in the file, root included
+            */
+            std::uint32_t getNodeCount() const;
+
+            /**
+            * @brief Returns kind of a node, node 0 is the root
+            */
+            ItemKind getKind(std::uint32_t node) const;
+
+            /**
+            * @brief Returns base label of a node, pointing into the mapped file
+            */
+            std::string_view getLabel(std::uint32_t node) const;
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+
+namespace mr{
+
+    /**
+    * @brief Navigation commands understood by MenuNavigator.
+    *
+    * Used to queue, record or replay input instead of calling the navigator directly.
+    */
+    enum class MenuEvent : std::uint8_t{
+        Next,
+        Previous,
+        Left,
+        Right,
+        Select,
+        Back
+    };
+}
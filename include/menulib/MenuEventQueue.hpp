@@ -0,0 +1,98 @@
+#pragma once
+#include "MenuEvent.hpp"
+#include "MenuNavigator.hpp"
+#include "MenuRecorder.hpp"
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Buffered, coalescing input front end of a MenuNavigator.
+    *
+    * Events can be posted from any thread and are applied in batches by process(),
+    * typically once per frame on the UI thread. Runs of consecutive events collapse:
+    * any mix of Next/Previous becomes a single move() by the net distance, and a run of
+    * Left or Right becomes a single step() by the run length, so a slider changes once
+    * and executes its function once. A change of step direction starts a new run because
+    * sliders stop at their bounds. Select and Back are applied one by one since they can
+    * change the page. The final state is the same as dispatching the events one by one.
+    */
+    class MenuEventQueue{
+        private:
+            MenuNavigator* m_navigator;
+
+            /**
+            * @brief Guards m_pending.
+            */
+            std::mutex m_mutex {};
+
+            /**
+            * @brief Events posted since the last process().
+            */
+            std::vector<MenuEvent> m_pending {};
+
+            /**
+            * @brief Events being processed, swapped with m_pending so both keep their capacity.
+            */
+            std::vector<MenuEvent> m_batch {};
+
+            /**
+            * @brief Recorder of posted events, nullptr when not recording.
+            */
+            MenuRecorder* m_recorder {};
+
+            std::size_t m_lastBatchSize {};
+            std::size_t m_lastDispatchCount {};
+
+        public:
+
+            /**
+            * @brief Creates a queue feeding a navigator
+            *
+            * @param navigator navigator receiving the events
+            */
+            explicit MenuEventQueue(MenuNavigator* navigator);
+
+            /**
+            * @brief Adds an event to the queue
+            *
+            * Safe to call from any thread.
+            *
+            * @param event event to add
+            */
+            void post(MenuEvent event);
+
+            /**
+            * @brief Records every event posted from now on
+            *
+            * Events are recorded as posted, before coalescing, under the queue's lock.
+            *
+            * @param recorder recorder to feed, nullptr to stop recording
+            */
+            void setRecorder(MenuRecorder* recorder);
+
+            /**
+            * @brief Applies all pending events to the navigator
+            *
+            * @return true if any event was processed and the menu should be redrawn
+            */
+            bool process();
+
+            /**
+            * @brief Returns count of events waiting for process()
+            */
+            std::size_t getPendingCount();
+
+            /**
+            * @brief Returns count of events drained by the last process()
+            */
+            std::size_t getLastBatchSize() const;
+
+            /**
+            * @brief Returns count of navigator calls the last batch was reduced to
+            */
+            std::size_t getLastDispatchCount() const;
+    };
+}
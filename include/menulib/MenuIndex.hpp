@@ -0,0 +1,116 @@
+#pragma once
+#include "IMenuObserver.hpp"
+#include "MenuPage.hpp"
+#include "MenuPaths.hpp"
+#include <cstddef>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mr{
+
+    /**
+    * @brief Hash index from item ID and from label path to every item of a menu tree.
+    *
+    * Paths are built by MenuPaths, so they match MenuSettings keys: the base labels
+    * of the pages leading to an item and its own, joined with '/'
+    * ("Settings/Audio/Volume"); a label repeated among siblings gets "#2", "#3"...
+    * appended, and '/', '#' and '\' in labels are escaped with '\'. The root itself
+    * has no path and is not indexed.
+    *
+    * The index attaches itself as an observer of the root and is kept up to date
+    * when items are added or removed and when labels change. An appended item is
+    * indexed in constant time; a removal or relabel only re-keys the siblings
+    * sharing the old or the new label, with their subtrees. Children of lazy pages
+    * (MenuPage::isLazy()) are not indexed.
+    *
+    * Lookups take a shared lock and may run on any thread, concurrently with
+    * changes of the tree; items found are only guaranteed to exist while the tree
+    * is not changed.
+    */
+    class MenuIndex : public IMenuObserver, private MenuPaths::Listener{
+        public:
+
+            /**
+            * @brief Indexed item, the page holding it and its position there.
+            */
+            struct Entry{
+                IMenuItem* item {};
+                MenuPage* page {};
+
+                /**
+                * @brief Position of the item in its page, -1 if it is not indexed.
+                */
+                int index {-1};
+            };
+
+        private:
+            MenuPage* m_root {};
+
+            mutable std::shared_mutex m_mutex {};
+
+            /**
+            * @brief Path of every indexed item; its nodes keep the text m_byPath refers to.
+            */
+            MenuPaths m_paths;
+
+            std::unordered_map<std::string_view, const MenuPaths::Node*> m_byPath {};
+            std::unordered_map<ItemId, const MenuPaths::Node*> m_byId {};
+
+            /**
+            * @brief Returns the entry of a node, called with m_mutex locked.
+            */
+            static Entry entryOf(const MenuPaths::Node* node);
+
+            void pathAdded(const MenuPaths::Node& node, bool renamed) override;
+            void pathRemoved(const MenuPaths::Node& node, bool renamed) override;
+
+        public:
+
+            /**
+            * @brief Indexes a tree and starts following its changes
+            *
+            * @param root root page of the tree
+            * @throws std::invalid_argument if root is nullptr
+            */
+            explicit MenuIndex(MenuPage* root);
+
+            /**
+            * @brief Detaches from the root
+            */
+            ~MenuIndex() override;
+
+            MenuIndex(const MenuIndex&) = delete;
+            MenuIndex& operator=(const MenuIndex&) = delete;
+
+            /**
+            * @brief Finds an item by its ID
+            *
+            * @return the item, its page and its position, nullptr and -1 if it is not in the tree
+            */
+            Entry find(ItemId id) const;
+
+            /**
+            * @brief Finds an item by its path
+            *
+            * @param path path such as "Settings/Audio/Volume"
+            * @return the item, its page and its position, nullptr and -1 if no item has the path
+            */
+            Entry find(std::string_view path) const;
+
+            /**
+            * @brief Returns the path of an item, empty if it is not indexed
+            */
+            std::string getPath(const IMenuItem* item) const;
+
+            /**
+            * @brief Returns count of indexed items
+            */
+            std::size_t size() const;
+
+            void onItemAdded(MenuPage* page, IMenuItem* item) override;
+            void onItemRemoved(MenuPage* page, IMenuItem* item) override;
+            void onLabelChanged(IMenuItem* item) override;
+    };
+}
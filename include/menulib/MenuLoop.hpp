@@ -0,0 +1,224 @@
+#pragma once
+#include "IMenuObserver.hpp"
+#include "InplaceFunction.hpp"
+#include "MenuEventQueue.hpp"
+#include "MenuNavigator.hpp"
+#include "MenuRenderer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace mr{
+
+    /**
+    * @brief Time spent in each phase of one frame.
+    */
+    struct FrameTimings{
+        /**
+        * @brief Index of the frame, counted from 0.
+        */
+        std::uint64_t frame {};
+        /**
+        * @brief Polling input and posting events.
+        */
+        std::chrono::nanoseconds input {};
+        /**
+        * @brief Applying events to the navigator and running the update hook.
+        */
+        std::chrono::nanoseconds update {};
+        /**
+        * @brief Drawing the frame, zero when it was skipped.
+        */
+        std::chrono::nanoseconds render {};
+        /**
+        * @brief Sum of the phases, without the time slept until the next frame.
+        */
+        std::chrono::nanoseconds total {};
+        bool rendered {};
+        /**
+        * @brief Set when total exceeded the frame budget.
+        */
+        bool overBudget {};
+    };
+
+    /**
+    * @brief Timings of all frames since the loop was created or reset.
+    */
+    struct FrameStats{
+        std::uint64_t frames {};
+        std::uint64_t renderedFrames {};
+        std::uint64_t overBudgetFrames {};
+        std::chrono::nanoseconds inputTotal {};
+        std::chrono::nanoseconds updateTotal {};
+        std::chrono::nanoseconds renderTotal {};
+        /**
+        * @brief Slowest frame seen, by total.
+        */
+        FrameTimings worst {};
+    };
+
+    /**
+    * @brief Fixed-rate driver of a menu: input, update and render phases per frame.
+    *
+    * Each tick() polls input through the input hook (which posts events and must
+    * not block), applies the queued events and runs the update hook, then renders,
+    * but only if something changed: an event was processed, a value, label or
+    * item changed anywhere in the navigator's tree, or requestRedraw() was called.
+    * run() repeats tick() at the target frame rate, sleeping out the rest of
+    * each frame, until stop().
+    *
+    * Every phase is timed; the last frame, running totals and the slowest frame
+    * are kept, and the frame hook sees each frame's timings as it ends, so frames
+    * over the budget (the frame period by default) can be spotted.
+    *
+    * The loop observes the root of the navigator's tree, which has to outlive it.
+    */
+    class MenuLoop : public IMenuObserver{
+        public:
+            using InputHook = MenuCallback<void(MenuEventQueue& events)>;
+            using UpdateHook = MenuCallback<void(std::chrono::nanoseconds elapsed)>;
+            using FrameHook = MenuCallback<void(const FrameTimings& timings)>;
+
+        private:
+            MenuNavigator* m_navigator;
+            MenuEventQueue* m_events;
+            MenuRenderer* m_renderer;
+            std::ostream& m_out;
+
+            /**
+            * @brief Observed root page, the navigator's root; nullptr if the navigator has no page tree.
+            */
+            MenuPage* m_root {};
+
+            InputHook m_input {};
+            UpdateHook m_update {};
+            FrameHook m_frameHook {};
+
+            std::chrono::nanoseconds m_period {};
+            std::chrono::nanoseconds m_budget {};
+            std::chrono::nanoseconds m_refreshInterval {};
+
+            /**
+            * @brief Set from any thread when the menu has to be drawn again.
+            */
+            std::atomic<bool> m_dirty {true};
+            std::atomic<bool> m_running {};
+
+            /**
+            * @brief Set by stop(), cleared when run() returns.
+            */
+            std::atomic<bool> m_stopRequested {};
+
+            std::chrono::steady_clock::time_point m_lastTick {};
+            std::chrono::steady_clock::time_point m_lastRender {};
+
+            FrameTimings m_lastFrame {};
+            FrameStats m_stats {};
+
+        public:
+
+            /**
+            * @brief Creates a loop running at 60 frames per second
+            *
+            * @param navigator navigator to draw, its tree is observed for changes
+            * @param events queue applied in the update phase
+            * @param renderer renderer used in the render phase
+            * @param out stream the frames are written to
+            * @throws std::invalid_argument if navigator, events or renderer is nullptr
+            */
+            MenuLoop(MenuNavigator* navigator, MenuEventQueue* events, MenuRenderer* renderer, std::ostream& out);
+
+            ~MenuLoop() override;
+
+            MenuLoop(const MenuLoop&) = delete;
+            MenuLoop& operator=(const MenuLoop&) = delete;
+
+            /**
+            * @brief Sets the frame rate of run() and resets the budget to one frame period
+            *
+            * @param framesPerSecond target rate, greater than 0
+            */
+            void setTargetFrameRate(double framesPerSecond);
+
+            /**
+            * @brief Sets the time a frame may take before it is reported over budget
+            */
+            void setFrameBudget(std::chrono::nanoseconds budget);
+
+            /**
+            * @brief Draws at least this often even when nothing was reported changed
+            *
+            * For displays changing without notifications, e.g. a clock drawn by
+            * the renderer. Zero (the default) disables it.
+            */
+            void setRefreshInterval(std::chrono::nanoseconds interval);
+
+            /**
+            * @brief Sets the input phase hook, called once per frame; it must not block
+            */
+            void setInputHook(InputHook hook);
+
+            /**
+            * @brief Sets the update phase hook, called after events were applied
+            *
+            * It gets the time since the previous frame began.
+            */
+            void setUpdateHook(UpdateHook hook);
+
+            /**
+            * @brief Sets the hook receiving every frame's timings when the frame ends
+            */
+            void setFrameHook(FrameHook hook);
+
+            /**
+            * @brief Runs a single frame without waiting
+            *
+            * @return true if the frame was drawn
+            */
+            bool tick();
+
+            /**
+            * @brief Runs frames at the target rate until stop() is called
+            *
+            * A frame running late starts the next one at once; the schedule is not
+            * caught up with a burst of frames.
+            */
+            void run();
+
+            /**
+            * @brief Makes run() return after the current frame, safe to call from any thread and from hooks
+            *
+            * Called while run() is not running, e.g. from another thread before it
+            * started, it makes the next run() return without running a frame.
+            */
+            void stop();
+
+            /**
+            * @brief Tells whether run() is running
+            */
+            bool isRunning() const;
+
+            /**
+            * @brief Makes the next frame draw, safe to call from any thread
+            */
+            void requestRedraw();
+
+            /**
+            * @brief Returns the timings of the last frame
+            */
+            const FrameTimings& getLastFrame() const;
+
+            /**
+            * @brief Returns the timings of all frames since creation or resetStats()
+            */
+            const FrameStats& getStats() const;
+
+            void resetStats();
+
+            void onItemAdded(MenuPage* page, IMenuItem* item) override;
+            void onItemRemoved(MenuPage* page, IMenuItem* item) override;
+            void onLabelChanged(IMenuItem* item) override;
+            void onValueChanged(IMenuItem* item) override;
+    };
+}
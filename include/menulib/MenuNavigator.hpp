@@ -1,22 +1,213 @@
 #pragma once
 #include "MenuPage.hpp"
+#include "FrozenMenu.hpp"
+#include "MenuEvent.hpp"
+#include <array>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mr{
 
+    class VariantMenuPage;
+    class MenuIndex;
+
     /**
     * @brief Controls navigation between menu pages and selection of items.
     *
     * MenuNavigator maintains the current menu page and highlighted item,
     * and provides operations for navigating and selecting menu entries.
+    * It runs either over a MenuPage tree or over its FrozenMenu form.
+    *
+    * Entering a submenu remembers the highlighted item of the page left, so
+    * back() puts the cursor where it was; back() in turn remembers the submenu
+    * for forward(). Both trails hold the last HistoryDepth steps, deeper steps
+    * back highlight the submenu just left.
     */
     class MenuNavigator{
+        public:
+
+            /**
+            * @brief Count of steps remembered by back() and forward() each
+            */
+            static constexpr int HistoryDepth = 32;
+
         private:
+
+            /**
+            * @brief Page and highlight to return to.
+            */
+            struct Position{
+                MenuPage* page {};
+                std::uint32_t node {};
+                int index {};
+                /**
+                * @brief Only compared, never dereferenced, like m_currentItem.
+                */
+                const IMenuItem* item {};
+            };
+
+            /**
+            * @brief Fixed size stack of positions, dropping the oldest one when full.
+            */
+            class History{
+                private:
+                    std::array<Position, HistoryDepth> m_entries {};
+                    int m_first {};
+                    int m_count {};
+
+                public:
+                    void push(const Position& position);
+                    void pop();
+                    const Position& top() const;
+                    void clear();
+                    bool empty() const;
+            };
+
             MenuPage* m_root {};
             MenuPage* m_currentMenu{};
-            int m_currentIndex{};
+
+            /**
+            * @brief Highlighted index, corrected by const reads when the page changed under it.
+            */
+            mutable int m_currentIndex{};
+
+            /**
+            * @brief Highlighted item in pointer mode, used to find the index again after the page changed.
+            *
+            * Only compared, never dereferenced, so it may outlive the item.
+            */
+            mutable const IMenuItem* m_currentItem {};
+
+            /**
+            * @brief Current page if it is a VariantMenuPage, whose items are read and dispatched without virtual calls.
+            */
+            VariantMenuPage* m_variantMenu {};
+
+            /**
+            * @brief Frozen menu walked instead of the page tree, nullptr in pointer mode.
+            */
+            FrozenMenu* m_frozen {};
+
+            /**
+            * @brief Node of the current page in frozen mode.
+            */
+            std::uint32_t m_frozenPage {};
+
+            /**
+            * @brief Count of rows visible at once, 0 means the whole page.
+            */
+            int m_viewportSize {};
+
+            /**
+            * @brief Index of the first visible item.
+            */
+            mutable int m_viewportOffset {};
+
+            /**
+            * @brief Pages left by entering a submenu, the parent of the current page on top.
+            */
+            History m_back {};
+
+            /**
+            * @brief Submenus left by back(), the last one on top.
+            */
+            History m_forward {};
+
+            /**
+            * @brief Scrolls the viewport the minimal amount needed to show the highlighted item.
+            */
+            void followCursor() const;
+
+            /**
+            * @brief Puts the highlight back on the remembered item if the current page changed
+            *
+            * Items may be added or removed between two calls (see ConcurrentMenuPage).
+            * If the highlighted item is gone, the index is clamped to the page.
+            *
+            * @param items pinned items of the current page
+            * @return count of items on the current page
+            */
+            int syncCursor(const MenuPage::ReadGuard& items) const;
+
+            /**
+            * @brief syncCursor() over any view of the current page's items
+            *
+            * @param items MenuPage::ReadGuard, or a VariantMenuPage read without a guard
+            * @param lazy true if the page's children are only known by their index
+            * @return count of items on the current page
+            */
+            template <typename Items>
+            int syncItems(const Items& items, bool lazy) const;
+
+            /**
+            * @brief trackCursor() over any view of the current page's items
+            */
+            template <typename Items>
+            void trackItems(const Items& items, bool lazy);
+
+            /**
+            * @brief Remembers the highlighted item and scrolls the viewport to it
+            *
+            * @param items pinned items of the current page
+            */
+            void trackCursor(const MenuPage::ReadGuard& items);
+
+            /**
+            * @brief Moves the highlight, pinning the current page in pointer mode only
+            *
+            * @param target returns the new index from the current one and the count of items,
+            *        only called on pages with items
+            */
+            template <typename F>
+            void moveCursor(F target);
+
+            /**
+            * @brief Opens the page holding an item and highlights it
+            *
+            * @param item item to highlight
+            * @param hint position of the item in its page if known, -1 otherwise; a stale
+            *        hint falls back to searching the page
+            * @return false if the item is not reachable from this navigator
+            */
+            bool openItem(const IMenuItem* item, int hint);
+
+            /**
+            * @brief Returns count of items on the current page with the highlight synced to it
+            *
+            * In frozen mode the count comes from the flat arrays without pinning the source page.
+            */
+            int syncCount() const;
+
+            /**
+            * @brief Switches to a page with the first item highlighted, leaving the history alone
+            *
+            * @param page page to show
+            */
+            void openPage(MenuPage* page);
+
+            /**
+            * @brief Returns the current page and highlight
+            */
+            Position currentPosition() const;
+
+            /**
+            * @brief Switches to a remembered page and highlight
+            *
+            * A negative index highlights the remembered item instead.
+            *
+            * @param position page and highlight to show
+            */
+            void restore(const Position& position);
+
+            /**
+            * @brief Moves to the parent page, restoring its highlight
+            *
+            * @return false if the current page has no parent
+            */
+            bool ascend();
 
         public:
             /**
@@ -28,6 +219,16 @@ namespace mr{
             */
             MenuNavigator(MenuPage* root);
 
+            /**
+            * @brief Frozen Menu Navigator constructor
+            *
+            * Creates a MenuNavigator walking the flattened form of a menu,
+            * starting at its root node
+            *
+            * @param frozen pointer to the frozen menu
+            */
+            MenuNavigator(FrozenMenu* frozen);
+
             /**
              * @brief highlights next item in menu page.
              */
@@ -48,24 +249,150 @@ namespace mr{
 
             /**
              * @brief changes current menu page to the one set as parent of menu page.
+             *
+             * The parent's highlight is put back where it was when the submenu was
+             * entered, or on the submenu if that is no longer known.
              */
             void back();
 
+            /**
+            * @brief Enters again the submenu left by the last back()
+            *
+            * Restores the highlight the submenu had when it was left. Selecting
+            * another page or jumping elsewhere forgets the forward steps.
+            *
+            * @return false if there is no step to redo or the submenu is no longer on the current page
+            */
+            bool forward();
+
+            /**
+            * @brief Goes back up to the top page, as repeated back() would
+            *
+            * Every level passed can be entered again with forward().
+            */
+            void root();
+
+            /**
+            * @brief Tells whether forward() has a step to redo
+            */
+            bool canGoForward() const;
+
+            /**
+            * @brief Returns count of pages above the current one
+            */
+            int getDepth() const;
+
+            /**
+            * @brief Fills the pages from the top down to the current one
+            *
+            * The vector is cleared first; reusing it keeps repeated calls free of allocation.
+            *
+            * @param pages receives the pages, the current page last
+            */
+            void getBreadcrumbs(std::vector<MenuPage*>& pages) const;
+
             /**
             * @brief Returns the items of the current menu page.
             *
+            * Only available when navigating a MenuPage tree, prefer getCurrentCount()
+            * and getCurrentLabel() which work over both forms.
+            *
             * @return Reference to the vector of menu items in the current page.
             */
-            const std::vector<IMenuItem*>& getCurrentItems() const;
+            const std::pmr::vector<IMenuItem*>& getCurrentItems() const;
+
+            /**
+            * @brief Returns count of items in the current menu page
+            *
+            * @return count of items
+            */
+            int getCurrentCount() const;
+
+            /**
+            * @brief Returns label of an item in the current menu page
+            *
+            * On pages changed from other threads the label may only be used while
+            * the page is pinned by a MenuPage::ReadGuard.
+            *
+            * @param index item index within the current page
+            * @return item's display label
+            */
+            std::string_view getCurrentLabel(int index) const;
+
+            /**
+            * @brief Returns the current menu page
+            *
+            * @return current page, the source page of the current node in frozen mode
+            */
+            MenuPage* getCurrentMenu() const;
+
+            /**
+            * @brief Returns the root page of the navigated tree
+            *
+            * @return page the navigator was created with, the source root page in frozen mode
+            */
+            MenuPage* getRoot() const;
+
+            /**
+            * @brief Returns the highlighted item
+            *
+            * On pages changed from other threads or created on demand the item
+            * may only be used while the page is pinned by a MenuPage::ReadGuard.
+            *
+            * @return highlighted item, nullptr on an empty page
+            */
+            IMenuItem* getCurrentItem() const;
+
+            /**
+            * @brief Tells whether the navigator walks a FrozenMenu
+            *
+            * @return true in frozen mode
+            */
+            bool isFrozen() const;
 
 
             /**
             * @brief Change current menu page to selected or previous (parent)
             *
+            * Entering a child of the current page is remembered for back(), any
+            * other page starts a new history.
+            *
             * @param currentMenu pointer to the menu page
             */
             void setCurrentMenu(MenuPage* currentMenu);
 
+            /**
+            * @brief Opens the page holding an item and highlights it
+            *
+            * Used to jump straight to a search hit.
+            *
+            * @param item item to highlight, must have been added to a page
+            * @return false if the item is not on a page below the navigated root
+            */
+            bool jumpTo(const IMenuItem* item);
+
+            /**
+            * @brief Opens the page holding the item with an ID and highlights it
+            *
+            * The index keeps the item's position, so the page is not searched.
+            *
+            * @param index index of the navigated tree
+            * @param id ID of the item
+            * @return false if no such item is indexed or it is not reachable from this navigator
+            */
+            bool jumpTo(const MenuIndex& index, ItemId id);
+
+            /**
+            * @brief Opens the page holding the item at a path and highlights it
+            *
+            * Deep link such as "Settings/Audio/Volume", see MenuIndex for the path format.
+            *
+            * @param index index of the navigated tree
+            * @param path path of the item
+            * @return false if no item has the path or it is not reachable from this navigator
+            */
+            bool jumpTo(const MenuIndex& index, std::string_view path);
+
             /**
             * @brief Returns current index (which item is highlighted)
             *
@@ -78,7 +405,7 @@ namespace mr{
             *
             * @return highlighted item's display label
             */
-            const std::string& getCurrentTitle() const;
+            std::string_view getCurrentTitle() const;
 
             /**
             * @brief highlights next item in menu page.
@@ -102,6 +429,73 @@ namespace mr{
             */
             void operator()();
 
+            /**
+            * @brief Sets how many rows of a page are shown at once
+            *
+            * @param rows visible rows, 0 to show whole pages
+            */
+            void setViewportSize(int rows);
+
+            /**
+            * @brief Returns count of visible rows, 0 if whole pages are shown
+            */
+            int getViewportSize() const;
+
+            /**
+            * @brief Returns index of the first visible item
+            */
+            int getViewportOffset() const;
+
+            /**
+            * @brief Returns index one past the last visible item
+            *
+            * Renderers draw items [getViewportOffset(), getViewportEnd()) only.
+            */
+            int getViewportEnd() const;
+
+            /**
+            * @brief highlights the item one viewport above, without wrapping
+            */
+            void pageUp();
+
+            /**
+            * @brief highlights the item one viewport below, without wrapping
+            */
+            void pageDown();
+
+            /**
+            * @brief highlights the first item in menu page
+            */
+            void first();
+
+            /**
+            * @brief highlights the last item in menu page
+            */
+            void last();
+
+            /**
+            * @brief moves the highlight by several items at once, wrapping like next()/previous()
+            *
+            * @param delta count of items, negative to move up
+            */
+            void move(int delta);
+
+            /**
+            * @brief applies several left/right moves to the highlighted item at once
+            *
+            * MenuStats counts them as |steps| Left or Right events of the item.
+            *
+            * @param steps count of moves, negative to the left
+            */
+            void step(int steps);
+
+            /**
+            * @brief executes a single navigation command
+            *
+            * @param event command to execute
+            */
+            void dispatch(MenuEvent event);
+
             /**
              * @brief moves slider type objects value to the left (decrement).
              */
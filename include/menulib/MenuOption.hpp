@@ -1,10 +1,44 @@
 #pragma once
 #include "IMenuItem.hpp"
+#include "InplaceFunction.hpp"
+#include "MenuThreadPool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <stdexcept>
 #include <string>
-#include <functional>
+#include <string_view>
 
 namespace mr{
+
+    /**
+    * @brief Progress of an option's action in asynchronous mode.
+    */
+    enum class ActionStatus : std::uint8_t{
+        Idle,
+        Pending,
+        Running,
+        Done,
+        Failed
+    };
+
+    /**
+    * @brief What selecting an option does while its previous run is still in flight.
+    */
+    enum class ReselectPolicy : std::uint8_t{
+        /**
+        * @brief The new selection is ignored.
+        */
+        Reject,
+        /**
+        * @brief The running action is asked to stop and the action runs again afterwards.
+        */
+        Cancel
+    };
+
     /**
     * @brief Menu Page item class.
     *
@@ -16,7 +50,42 @@ namespace mr{
             /**
             * @brief Function attached for the item to execute
             */
-            std::function<void()> m_func {};
+            MenuCallback<void()> m_func {};
+
+            /**
+            * @brief State shared with the jobs queued on the thread pool.
+            *
+            * Jobs keep it alive, so they can find out the option was destroyed.
+            */
+            struct AsyncState{
+                std::mutex mutex {};
+                std::condition_variable finished {};
+                std::atomic<ActionStatus> status {ActionStatus::Idle};
+                std::atomic<bool> cancelRequested {};
+                bool running {};
+                bool rerun {};
+                bool detached {};
+            };
+
+            /**
+            * @brief Pool running the action, nullptr in synchronous mode.
+            */
+            MenuThreadPool* m_pool {};
+
+            ReselectPolicy m_policy {ReselectPolicy::Reject};
+
+            std::shared_ptr<AsyncState> m_async {};
+
+            /**
+            * @brief Display label with the status suffix returned by getLabel(), created on its first call.
+            */
+            mutable std::unique_ptr<std::string> m_labelCache {};
+
+            /**
+            * @brief Body of a pool job, runs the action until no rerun was requested.
+            */
+            static void runJob(const std::shared_ptr<AsyncState>& state, MenuOption* option);
+
         public:
 
             /**
@@ -25,8 +94,9 @@ namespace mr{
             * Creates a placeholder instance with given label, which doesn't have a function
             *
             * @param label Display text label
+            * @param resource memory resource used for the label
             */
-            MenuOption(const std::string& label);
+            MenuOption(std::string_view label, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
             /**
             * @brief Parametric constructor
@@ -35,17 +105,76 @@ namespace mr{
             *
             * @param label Display text label
             * @param func Function to execute when selected
+            * @param resource memory resource used for the label
             */
-            MenuOption(const std::string& label, const std::function<void()>& func);
+            MenuOption(std::string_view label, MenuCallback<void()> func,
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
 
+            /**
+            * @brief Waits for an in-flight asynchronous run to finish.
+            *
+            * The run announces its status under MenuPage::ObserverLock, so the
+            * option must not be destroyed while that lock is held.
+            */
+            ~MenuOption() override;
 
             /**
             * @brief Executes the function associated with this menu option.
             *
-            * Typically called when the item is selected.
+            * Typically called when the item is selected. Always synchronous.
             */
             void execute() const;
 
+            /**
+            * @brief Switches the option to asynchronous mode
+            *
+            * When selected, the function is then queued on the pool and the
+            * navigator returns immediately. Each status change is announced to
+            * observers with onLabelChanged(), from the worker thread once the
+            * action started; they should read the label there with appendLabel(),
+            * as getLabel() is only safe on the navigating thread.
+            *
+            * @param pool pool running the function, nullptr to go back to synchronous mode
+            * @param policy what to do when selected while still in flight
+            */
+            void setAsync(MenuThreadPool* pool, ReselectPolicy policy = ReselectPolicy::Reject);
+
+            /**
+            * @brief Returns progress of the asynchronous action
+            *
+            * @return ActionStatus::Idle in synchronous mode or before the first selection
+            */
+            ActionStatus getStatus() const;
+
+            /**
+            * @brief Blocks until no asynchronous run is pending or running.
+            */
+            void wait() const;
+
+            /**
+            * @brief Tells an asynchronous action it should stop early
+            *
+            * Meant to be polled from inside the attached function.
+            *
+            * @return true if the action running on this thread was cancelled by a reselection
+            */
+            static bool cancellationRequested();
+
+            /**
+            * @brief Appends the label, with the status suffix in asynchronous mode
+            *
+            * @param out line to append to
+            */
+            void appendLabel(std::string& out) const override;
+
+            /**
+            * @brief Returns display label, with the status suffix in asynchronous mode
+            *
+            * @return label such as "Load [running]"
+            */
+            std::string_view getLabel() const override;
+
             /**
             * @brief Indicates whether this item represents a terminal menu entry.
             *
@@ -55,7 +184,15 @@ namespace mr{
             bool isEnd() const override;
 
             /**
-            * @brief When selected executes the function by calling execute()
+            * @brief Returns the category of this item.
+            *
+            * @return ItemKind::Option
+            */
+            ItemKind getKind() const override;
+
+            /**
+            * @brief When selected executes the function by calling execute(),
+            * or queues it on the pool in asynchronous mode
             *
             * @param navigator Pointer to the menu navigator
             */
@@ -1,7 +1,12 @@
 #pragma once
 #include "IMenuItem.hpp"
+#include "IMenuObserver.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mr{
@@ -19,8 +24,9 @@ namespace mr{
             *
             * Contains pointers to submenu pages and action items.
             * Private to enforce validation through addItem().
+            * Allocated from the same memory resource as the page label.
             */
-            std::vector<IMenuItem*> m_items {};
+            std::pmr::vector<IMenuItem*> m_items;
 
             /**
             * @brief Parent pointer.
@@ -29,8 +35,170 @@ namespace mr{
             */
             MenuPage* m_parent {};
 
+            /**
+            * @brief Observers notified about changes in this page's subtree.
+            */
+            std::pmr::vector<IMenuObserver*> m_observers;
+
+        protected:
+
+            /**
+            * @brief Starts a read of the page's items
+            *
+            * Pages whose items change concurrently pin a consistent snapshot here.
+            *
+            * @return handle passed back to pinnedCount(), pinnedItem() and releaseItems()
+            */
+            virtual const void* acquireItems() const;
+
+            /**
+            * @brief Ends a read started by acquireItems()
+            */
+            virtual void releaseItems(const void* pin) const;
+
+            /**
+            * @brief Returns count of items in a pinned read
+            */
+            virtual int pinnedCount(const void* pin) const;
+
+            /**
+            * @brief Returns an item of a pinned read, index must be below pinnedCount()
+            */
+            virtual IMenuItem* pinnedItem(const void* pin, int index) const;
+
+            /**
+            * @brief Returns index of an item in a pinned read, -1 if it is not there
+            *
+            * Pages creating items on demand only look at the items they hold.
+            */
+            virtual int pinnedIndexOf(const void* pin, const IMenuItem* item) const;
+
+            /**
+            * @brief Makes this page the owner (and parent, for pages without one) of an item
+            */
+            void adopt(IMenuItem* item);
+
+            /**
+            * @brief Takes an item off the page and notifies observers, without destroying it
+            *
+            * @return false if the item is not on this page
+            */
+            bool detachItem(IMenuItem* item);
+
+            /**
+            * @brief Forgets all items without destroying them, for pages owning their items' storage
+            */
+            void detachItems();
+
+            /**
+            * @brief Calls f(observer) for the observers of this page and the pages above, under ObserverLock.
+            */
+            template <typename F>
+            void forEachObserver(F f);
+
+            /**
+            * @brief Tells observers of this page and the pages above that an item was added
+            */
+            void notifyItemAdded(IMenuItem* item);
+
+            /**
+            * @brief Tells observers of this page and the pages above that an item was removed
+            */
+            void notifyItemRemoved(IMenuItem* item);
+
         public:
 
+            /**
+            * @brief Consistent, read-only view of a page's items.
+            *
+            * Every read of a page's items goes through a guard: count and items come
+            * from the same snapshot and the items stay alive until the guard is destroyed,
+            * even on pages modified from other threads (see ConcurrentMenuPage).
+            */
+            class ReadGuard{
+                private:
+                    const MenuPage* m_page;
+                    const void* m_pin;
+
+                public:
+
+                    /**
+                    * @brief Pins the current items of a page
+                    *
+                    * @param page page to read
+                    */
+                    explicit ReadGuard(const MenuPage& page) : m_page(&page), m_pin(page.acquireItems()) {}
+
+                    /**
+                    * @brief Releases the pinned items
+                    */
+                    ~ReadGuard()
+                    {
+                        m_page->releaseItems(m_pin);
+                    }
+
+                    ReadGuard(const ReadGuard&) = delete;
+                    ReadGuard& operator=(const ReadGuard&) = delete;
+
+                    /**
+                    * @brief Returns count of pinned items
+                    */
+                    int count() const
+                    {
+                        return m_page->pinnedCount(m_pin);
+                    }
+
+                    /**
+                    * @brief Returns a pinned item
+                    *
+                    * @param index item index, must be below count()
+                    */
+                    IMenuItem* at(int index) const
+                    {
+                        return m_page->pinnedItem(m_pin, index);
+                    }
+
+                    /**
+                    * @brief Returns index of a pinned item, -1 if it is not there
+                    *
+                    * @param item item to look for
+                    */
+                    int indexOf(const IMenuItem* item) const
+                    {
+                        return m_page->pinnedIndexOf(m_pin, item);
+                    }
+            };
+
+            /**
+            * @brief Holds off the delivery of notifications on all pages.
+            *
+            * Observers are called one at a time, on the thread making the change,
+            * with this lock held; it also guards the observer lists. An observer whose
+            * state is read from other threads takes it around those reads, or keeps a
+            * lock of its own that it only takes inside the lock or without calling back
+            * into the tree. Items known to an observer stay alive while it is held,
+            * their removal is only completed after the observer was told.
+            *
+            * The lock is recursive, an observer may change values from a callback. It
+            * must not be held while modifying a ConcurrentMenuPage from another thread.
+            */
+            class ObserverLock{
+                public:
+
+                    /**
+                    * @brief Waits for the notification in progress and blocks the next ones
+                    */
+                    ObserverLock();
+
+                    /**
+                    * @brief Lets notifications through again
+                    */
+                    ~ObserverLock();
+
+                    ObserverLock(const ObserverLock&) = delete;
+                    ObserverLock& operator=(const ObserverLock&) = delete;
+            };
+
             /**
             * @brief Placeholder Menu Page constructor
             *
@@ -42,11 +210,18 @@ namespace mr{
             * @brief Parametric Menu Page constructor
             *
             * Creates a menu page item with given title and parent.
+            *
+            * @param title page title
+            * @param parent parent page, nullptr for the root
+            * @param resource memory resource used for the label and the child list
             */
-           MenuPage(const std::string& title, MenuPage* parent = nullptr);
+           MenuPage(std::string_view title, MenuPage* parent = nullptr,
+                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
            /**
             * @brief Destroys the menu page and releases owned items.
+            *
+            * Items allocated in a MenuArena are left to the arena.
             */
            ~MenuPage() override;
 
@@ -54,21 +229,120 @@ namespace mr{
            /**
            * @brief Add an item to items vector
            *
+           * The page becomes the item's owner and, for a page without a parent,
+           * its parent. Observers of this page and the pages above it are notified.
+           *
            * @param item pointer to an item to append.
            */
-           void addItem(IMenuItem* item);
+           virtual void addItem(IMenuItem* item);
+
+           /**
+           * @brief Removes an item and destroys it
+           *
+           * Observers are notified before the item is destroyed. Items allocated in
+           * a MenuArena are left to the arena.
+           *
+           * @param item item to remove
+           * @return false if the item is not on this page
+           */
+           virtual bool removeItem(IMenuItem* item);
+
+           /**
+           * @brief Tells whether items are created on demand and may be destroyed while the page lives
+           *
+           * Code keeping item pointers across calls (search index, FrozenMenu) does not
+           * descend into lazy pages. Observers are not told about their items. Pages
+           * building their items on demand but keeping every one of them, like those
+           * of MenuBinary, are not lazy.
+           *
+           * @return true for pages like ProviderMenuPage
+           */
+           virtual bool isLazy() const;
+
+           /**
+           * @brief Does the expensive part of preparing the page's items
+           *
+           * May run on a worker thread ahead of time (see MenuPrefetcher), must not
+           * touch the page's item list or its observers. Plain pages have nothing to do.
+           */
+           virtual void prefetch();
+
+           /**
+           * @brief Tells whether prefetch() has nothing left to do
+           *
+           * @return true for plain pages
+           */
+           virtual bool isPrefetched() const;
+
+           /**
+           * @brief Returns a task running prefetch(), queued by MenuPrefetcher on a worker thread
+           *
+           * The default task calls prefetch() on this page, which must then outlive it.
+           * Pages that may be destroyed while their task is queued or running, like
+           * DeferredMenuPage, return a task holding shared state instead.
+           */
+           virtual std::function<void()> prefetchTask();
+
+           /**
+           * @brief Makes the page's items ready, called on the navigating thread before the page is entered
+           *
+           * Waits for a prefetch() in flight instead of repeating it. Plain pages have nothing to do.
+           */
+           virtual void populate();
+
+           /**
+           * @brief Attaches an observer to this page's subtree
+           *
+           * Callable from any thread. Attach it under an ObserverLock while building the
+           * observer's state from the tree, so no change slips in between.
+           *
+           * @param observer observer to notify, must outlive its registration
+           */
+           void addObserver(IMenuObserver* observer);
+
+           /**
+           * @brief Detaches an observer
+           *
+           * Callable from any thread, waits for the notification in progress.
+           *
+           * @param observer previously attached observer
+           */
+           void removeObserver(IMenuObserver* observer);
+
+           /**
+           * @brief Tells observers of this page and the pages above that an item label changed
+           *
+           * Called by IMenuItem::setLabel().
+           *
+           * @param item item whose label changed
+           */
+           void notifyLabelChanged(IMenuItem* item);
+
+           /**
+           * @brief Tells observers of this page and the pages above that an item value changed
+           *
+           * Called by stateful items, possibly from other threads.
+           *
+           * @param item item whose value changed
+           */
+           void notifyValueChanged(IMenuItem* item);
 
            /**
            * @brief Returns the items vector
            *
+           * Pages that store their items elsewhere (e.g. ConcurrentMenuPage) return
+           * an empty vector, use ReadGuard to read any kind of page.
+           *
            * @return Reference to the vector of contained menu items.
            */
-           const std::vector<IMenuItem*>& getItems() const;
+           const std::pmr::vector<IMenuItem*>& getItems() const;
 
            /**
            * @brief Returns a singular item of items vector by index
            *
-           *
+           * @param index item index
+           * @return item pointer
+           * @throws std::out_of_range if index is not below getCount()
            */
            IMenuItem* getItem(int index) const;
 
@@ -102,5 +376,12 @@ namespace mr{
            *         false if it leads to a submenu.
            */
            bool isEnd() const override;
+
+           /**
+           * @brief Returns the category of this item.
+           *
+           * @return ItemKind::Page
+           */
+           ItemKind getKind() const override;
     };
 }
@@ -0,0 +1,191 @@
+#pragma once
+#include "MenuPage.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Label path of every item of a menu tree, kept current as the tree changes.
+    *
+    * A path is made of the base labels of the pages leading to an item and its own,
+    * joined with '/' ("Settings/Audio/Volume"); a label repeated among siblings gets
+    * "#2", "#3"... appended in page order, and '/', '#' and '\' in labels are escaped
+    * with '\', so a label like "A#2" never takes the path of a numbered sibling. The
+    * root itself has no path. Children of lazy pages (MenuPage::isLazy()) are not
+    * tracked.
+    *
+    * Siblings are grouped by label, so an appended item is numbered in constant time
+    * and a removal or relabel only re-keys the siblings sharing the old or the new
+    * label, with everything below them. Each change is reported to a Listener,
+    * removed paths first, so a path taken over by another item is already free.
+    *
+    * Shared by MenuIndex and MenuSettings, it is not synchronized: the owner feeds it
+    * its observer callbacks and guards it with its own lock.
+    */
+    class MenuPaths{
+        public:
+
+            /**
+            * @brief Tracked item.
+            */
+            struct Node{
+                IMenuItem* item {};
+                MenuPage* page {};
+
+                /**
+                * @brief Position of the item in its page.
+                */
+                int index {};
+
+                /**
+                * @brief Position among the siblings sharing its label, from 1.
+                */
+                int number {};
+
+                /**
+                * @brief Base label the path was built from.
+                */
+                std::string label {};
+
+                std::string path {};
+            };
+
+            /**
+            * @brief Receives the paths that appear and disappear.
+            */
+            class Listener{
+                public:
+                    virtual ~Listener() = default;
+
+                    /**
+                    * @brief Called before a path is dropped
+                    *
+                    * @param node item keeping its old path for the duration of the call
+                    * @param renamed true if the item stays in the tree under another path
+                    */
+                    virtual void pathRemoved(const Node& node, bool renamed) = 0;
+
+                    /**
+                    * @brief Called once a path is assigned
+                    *
+                    * @param node item and its new path
+                    * @param renamed true if the item was already in the tree under another path
+                    */
+                    virtual void pathAdded(const Node& node, bool renamed) = 0;
+            };
+
+        private:
+
+            /**
+            * @brief Tracked children of a page.
+            */
+            struct Siblings{
+                std::vector<Node*> items {};
+
+                /**
+                * @brief Children of every label in page order.
+                */
+                std::unordered_map<std::string, std::vector<Node*>> byLabel {};
+            };
+
+            MenuPage* m_root {};
+
+            /**
+            * @brief Node of every tracked item, node addresses stay valid until it is removed.
+            */
+            std::unordered_map<const IMenuItem*, Node> m_nodes {};
+
+            /**
+            * @brief Children of the root and of every tracked page that is not lazy.
+            */
+            std::unordered_map<const MenuPage*, Siblings> m_pages {};
+
+            /**
+            * @brief Returns the tracked children of an item, nullptr unless it is a tracked page that is not lazy.
+            */
+            const Siblings* childrenOf(const IMenuItem* item) const;
+
+            void addChild(Siblings& siblings, MenuPage* page, IMenuItem* item, Listener& listener);
+            void addChildren(MenuPage* page, Listener& listener);
+
+            /**
+            * @brief Reports the paths of a node and everything below it as removed.
+            */
+            void reportRemoved(const Node& node, bool renamed, Listener& listener) const;
+
+            /**
+            * @brief Builds the path of a node and everything below it again and reports them.
+            */
+            void assignPaths(Node& node, Listener& listener);
+
+            /**
+            * @brief Forgets a node and everything below it.
+            */
+            void forget(const Node& node);
+
+            /**
+            * @brief Re-keys nodes whose number changed, with everything below them.
+            */
+            void rename(const std::vector<Node*>& nodes, Listener& listener);
+
+            /**
+            * @brief Returns the path prefix of a page's children, empty for the root.
+            */
+            std::string prefixOf(const MenuPage* page) const;
+
+        public:
+
+            /**
+            * @brief Appends a label escaped so '/' only ever separates path parts and '#' only starts a number
+            *
+            * @param path path to append to
+            * @param label base label of an item
+            */
+            static void appendLabel(std::string& path, std::string_view label);
+
+            /**
+            * @brief Parametric Menu Paths constructor, nothing is tracked until build()
+            *
+            * @param root root page of the tree
+            */
+            explicit MenuPaths(MenuPage* root);
+
+            /**
+            * @brief Tracks every item of the tree, reporting each path as added
+            */
+            void build(Listener& listener);
+
+            /**
+            * @brief Tracks an item appended to a page, with everything below it
+            *
+            * Items added to pages that are not tracked are ignored.
+            */
+            void add(MenuPage* page, IMenuItem* item, Listener& listener);
+
+            /**
+            * @brief Forgets an item removed from its page, with everything below it
+            *
+            * Later siblings sharing its label move down a number.
+            */
+            void remove(MenuPage* page, IMenuItem* item, Listener& listener);
+
+            /**
+            * @brief Re-keys an item whose base label changed and the siblings numbered after it
+            */
+            void relabel(IMenuItem* item, Listener& listener);
+
+            /**
+            * @brief Returns the node of an item, nullptr if it is not tracked
+            */
+            const Node* find(const IMenuItem* item) const;
+
+            /**
+            * @brief Returns count of tracked items
+            */
+            std::size_t size() const;
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "MenuNavigator.hpp"
+#include "MenuThreadPool.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace mr{
+
+    /**
+    * @brief Prefetches the submenu under the cursor while the user rests on it.
+    *
+    * Once the highlight stays on a page entry for the dwell time, the page's
+    * prefetch() is queued on a thread pool, so entering the page later only has
+    * to attach the prepared items. At most a configured count of prefetches run
+    * at once; entries seen while the limit is reached are retried on later updates.
+    *
+    * The prefetcher is driven by update(), called from the input loop. It queues
+    * MenuPage::prefetchTask(), so a page destroyed meanwhile, e.g. evicted from a
+    * ProviderMenuPage, is handled by the page itself. A page is handed to the pool
+    * once per visit of the cursor; a prefetch that failed is retried on the next
+    * visit. The destructor waits for all prefetches in flight.
+    */
+    class MenuPrefetcher{
+        public:
+            using Clock = std::chrono::steady_clock;
+
+        private:
+
+            /**
+            * @brief State shared with the jobs queued on the thread pool.
+            */
+            struct Jobs{
+                std::mutex mutex {};
+                std::condition_variable finished {};
+                std::size_t inFlight {};
+
+                /**
+                * @brief Pages whose prefetch is queued or running, only compared, never dereferenced.
+                */
+                std::unordered_set<const MenuPage*> pages {};
+            };
+
+            MenuThreadPool* m_pool {};
+            Clock::duration m_dwell {};
+            std::size_t m_maxInFlight {};
+            std::shared_ptr<Jobs> m_jobs {};
+
+            /**
+            * @brief Page entry the cursor rests on, nullptr if it is not on a page.
+            */
+            const MenuPage* m_candidate {};
+
+            /**
+            * @brief When the cursor arrived at the candidate.
+            */
+            Clock::time_point m_since {};
+
+            /**
+            * @brief Set once the candidate was handed to the pool during the current visit.
+            */
+            bool m_candidateStarted {};
+
+            std::size_t m_startedCount {};
+
+        public:
+
+            /**
+            * @brief Parametric Menu Prefetcher constructor
+            *
+            * @param pool pool running the prefetches, must outlive the prefetcher
+            * @param dwell time the cursor has to rest on an entry, zero to prefetch right away
+            * @param maxInFlight count of prefetches allowed to run at once, at least one
+            */
+            MenuPrefetcher(MenuThreadPool* pool, Clock::duration dwell, std::size_t maxInFlight = 1);
+
+            /**
+            * @brief Waits for the prefetches in flight
+            */
+            ~MenuPrefetcher();
+
+            MenuPrefetcher(const MenuPrefetcher&) = delete;
+            MenuPrefetcher& operator=(const MenuPrefetcher&) = delete;
+
+            /**
+            * @brief Looks at the highlighted item and starts a prefetch when it is due
+            *
+            * @param navigator navigator whose cursor is followed
+            * @param now current time
+            * @return true if a prefetch was started
+            */
+            bool update(const MenuNavigator& navigator, Clock::time_point now = Clock::now());
+
+            /**
+            * @brief Waits until no prefetch is in flight
+            */
+            void wait();
+
+            /**
+            * @brief Returns count of prefetches in flight
+            */
+            std::size_t getInFlightCount() const;
+
+            /**
+            * @brief Returns count of prefetches handed to the pool so far
+            */
+            std::size_t getStartedCount() const;
+    };
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "MenuEvent.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Navigation event with the time it was posted.
+    */
+    struct TraceEvent{
+        MenuEvent event;
+        /**
+        * @brief Microseconds since the recording started.
+        */
+        std::uint64_t timeUs;
+    };
+
+    /**
+    * @brief Records timestamped navigation events of a session into a trace file.
+    *
+    * Attach it to a MenuEventQueue with setRecorder() and every posted event is
+    * recorded with its time, or call record() directly. The trace is replayed
+    * headlessly with MenuReplayer.
+    *
+    * File format (version 1): the magic "MENUTRC\0", the version and the event
+    * count as little-endian 32 and 64-bit integers, then per event one byte with
+    * the MenuEvent followed by the microseconds since the previous event as an
+    * unsigned LEB128 varint. An event takes 2 bytes when it follows the previous
+    * one within 128 us, 3 bytes within 16 ms, 4 bytes within about 2 s, which
+    * covers typical gaps between keypresses, and 5 bytes up to about 4.5 minutes.
+    *
+    * Not synchronized: calls from several threads need external locking, which
+    * MenuEventQueue provides for the events posted through it.
+    */
+    class MenuRecorder{
+        public:
+
+            /**
+            * @brief Current file format version.
+            */
+            static constexpr std::uint32_t Version = 1;
+
+        private:
+            std::vector<TraceEvent> m_events {};
+            std::chrono::steady_clock::time_point m_start {std::chrono::steady_clock::now()};
+
+        public:
+
+            /**
+            * @brief Creates an empty recording, its clock starts now
+            */
+            MenuRecorder() = default;
+
+            /**
+            * @brief Records an event at the current time
+            */
+            void record(MenuEvent event);
+
+            /**
+            * @brief Records an event at a given time
+            *
+            * @param event recorded event
+            * @param timeUs microseconds since the start, not earlier than the last event
+            * @throws std::invalid_argument if the time goes back
+            */
+            void record(MenuEvent event, std::uint64_t timeUs);
+
+            /**
+            * @brief Discards recorded events and restarts the clock
+            */
+            void restart();
+
+            /**
+            * @brief Returns recorded events in order
+            */
+            const std::vector<TraceEvent>& getEvents() const;
+
+            /**
+            * @brief Writes the recording to a trace file
+            *
+            * @param path file to write
+            * @throws std::runtime_error if the file cannot be written
+            */
+            void save(const std::string& path) const;
+
+            /**
+            * @brief Reads the events of a trace file
+            *
+            * @param path file to read
+            * @return events in recorded order
+            * @throws std::runtime_error if the file cannot be read or is malformed
+            */
+            static std::vector<TraceEvent> load(const std::string& path);
+    };
+}
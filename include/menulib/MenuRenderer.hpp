@@ -0,0 +1,117 @@
+#pragma once
+#include "MenuNavigator.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Differential terminal renderer for a MenuNavigator.
+    *
+    * MenuRenderer draws the current page as a list of lines (title, items with the
+    * highlighted one marked, footer) and remembers the last frame it drew. On the
+    * next frame only lines that changed are rewritten, using ANSI cursor positioning
+    * and erase-to-end-of-line, and only from the first differing column. The whole
+    * frame goes out in a single buffered write.
+    *
+    * Only the navigator's viewport is drawn, so the cost of a frame depends on the
+    * visible rows rather than the size of the page.
+    *
+    * The terminal has to understand ANSI/VT100 escape sequences.
+    */
+    class MenuRenderer{
+        private:
+
+            /**
+            * @brief Lines of the frame currently on screen.
+            */
+            std::vector<std::string> m_previous {};
+
+            /**
+            * @brief Lines of the frame being built, swapped with m_previous after drawing.
+            */
+            std::vector<std::string> m_current {};
+
+            /**
+            * @brief Lines appended under the item list.
+            */
+            std::vector<std::string> m_footer {};
+
+            /**
+            * @brief Escape sequences and text of one frame, reused between frames.
+            */
+            std::string m_output {};
+
+            /**
+            * @brief Forces the next frame to clear the screen and draw everything.
+            */
+            bool m_fullRedraw {true};
+
+            std::size_t m_lastFrameBytes {};
+            std::size_t m_lastChangedLines {};
+            std::size_t m_totalBytes {};
+
+            /**
+            * @brief Returns line i of the frame being built, reusing its storage.
+            */
+            std::string& lineAt(std::size_t i);
+
+            /**
+            * @brief Fills m_current from the navigator state.
+            *
+            * @return count of lines in the frame
+            */
+            std::size_t buildFrame(const MenuNavigator& navigator);
+
+            /**
+            * @brief Appends the cursor move to the given row and column (both 1-based).
+            */
+            void moveTo(std::size_t row, std::size_t column);
+
+        public:
+
+            /**
+            * @brief Sets lines drawn under the item list (key help, prompt...).
+            *
+            * The last footer line is left without a line break and the terminal
+            * cursor is placed at its end.
+            *
+            * @param lines footer lines
+            */
+            void setFooter(const std::vector<std::string>& lines);
+
+            /**
+            * @brief Draws the navigator's current page, writing only what changed.
+            *
+            * @param navigator navigator to draw
+            * @param out stream receiving the escape sequences, flushed once per frame
+            * @return count of bytes written for this frame
+            */
+            std::size_t render(const MenuNavigator& navigator, std::ostream& out);
+
+            /**
+            * @brief Makes the next frame a full redraw.
+            *
+            * Call it whenever something else has written to the terminal.
+            */
+            void invalidate();
+
+            /**
+            * @brief Returns count of bytes written by the last frame
+            */
+            std::size_t getLastFrameBytes() const;
+
+            /**
+            * @brief Returns count of lines rewritten by the last frame
+            */
+            std::size_t getLastChangedLines() const;
+
+            /**
+            * @brief Returns count of bytes written since the renderer was created
+            */
+            std::size_t getTotalBytes() const;
+    };
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "MenuNavigator.hpp"
+#include "MenuRecorder.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Outcome of a replay.
+    */
+    struct ReplayResult{
+        std::size_t events {};
+        /**
+        * @brief Wall time of the replay, including waits at recorded speed.
+        */
+        std::chrono::nanoseconds elapsed {};
+        double eventsPerSecond {};
+        /**
+        * @brief MenuReplayer::stateHash() of the tree after the last event.
+        */
+        std::uint64_t stateHash {};
+    };
+
+    /**
+    * @brief Plays a recorded trace back against a menu tree, without a terminal.
+    *
+    * Events are dispatched to the navigator one by one, either back to back or
+    * at the recorded times. The hash of all toggle and slider values afterwards
+    * identifies the final state, so replaying a session against a freshly built
+    * menu gives the same hash every time; a different hash means the menu
+    * behaved differently.
+    */
+    class MenuReplayer{
+        public:
+
+            /**
+            * @brief Pacing of a replay
+            */
+            enum class Speed{
+                Unpaced,    ///< as fast as possible
+                Recorded    ///< each event waits for its recorded time
+            };
+
+        private:
+            std::vector<TraceEvent> m_events;
+
+        public:
+
+            /**
+            * @brief Creates a replayer of recorded events
+            *
+            * @param events events in recorded order
+            */
+            explicit MenuReplayer(std::vector<TraceEvent> events);
+
+            /**
+            * @brief Creates a replayer of a trace file
+            *
+            * @param path file written by MenuRecorder::save()
+            * @throws std::runtime_error if the file cannot be read or is malformed
+            */
+            explicit MenuReplayer(const std::string& path);
+
+            /**
+            * @brief Dispatches all events to a navigator
+            *
+            * @param navigator navigator of the menu to drive
+            * @param speed pacing of the events
+            * @return count of events, time taken, throughput and the final state hash
+            * @throws std::invalid_argument if navigator is nullptr
+            */
+            ReplayResult replay(MenuNavigator* navigator, Speed speed = Speed::Unpaced) const;
+
+            /**
+            * @brief Returns the events being replayed
+            */
+            const std::vector<TraceEvent>& getEvents() const;
+
+            /**
+            * @brief Hashes the values of all toggles and sliders of a tree
+            *
+            * 64-bit FNV-1a over the states and values in depth-first order, so it
+            * also changes when items move. Children of lazy pages are not visited.
+            *
+            * @param root root page of the tree
+            * @return hash of the tree's values
+            */
+            static std::uint64_t stateHash(const MenuPage* root);
+    };
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include "IMenuObserver.hpp"
+#include "MenuPage.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Single search result.
+    */
+    struct SearchHit{
+        /**
+        * @brief Matching item.
+        */
+        IMenuItem* item;
+
+        /**
+        * @brief Page holding the item.
+        */
+        MenuPage* page;
+    };
+
+    /**
+    * @brief Type-ahead search index over all labels of a menu tree.
+    *
+    * Every word of every label is inserted into a prefix trie (case-insensitive,
+    * ASCII), so "set" finds "Video Settings". Only the first MaxDepth characters of
+    * each word are stored; queries reaching past the first word or past MaxDepth,
+    * such as "video s", walk the trie with their first word and are verified
+    * against the stored label. Trie nodes left without items are freed, so
+    * relabelling and removing items does not grow the index.
+    *
+    * The index attaches itself as an observer of the root page and is updated
+    * incrementally when items are added or labels change. Base labels are indexed,
+    * so slider values and toggle states are not searchable. Children of lazy pages
+    * (MenuPage::isLazy()) are not indexed.
+    *
+    * Queries take a shared lock and may run on any thread, concurrently with changes
+    * of the tree made on other threads (see ConcurrentMenuPage); items found are only
+    * guaranteed to exist while the tree is not changed.
+    */
+    class MenuSearchIndex : public IMenuObserver{
+        public:
+
+            /**
+            * @brief Count of characters of a word stored in the trie.
+            */
+            static constexpr std::size_t MaxDepth = 32;
+
+            /**
+            * @brief Incremental query typed one character at a time.
+            *
+            * Keeps the trie position of every typed prefix, so push() and pop()
+            * cost O(1) regardless of the index size.
+            */
+            class TypeAhead{
+                friend class MenuSearchIndex;
+
+                private:
+                    const MenuSearchIndex* m_index;
+                    std::string m_text {};
+                    mutable std::vector<std::uint32_t> m_nodes {};
+
+                    /**
+                    * @brief MenuSearchIndex::m_generation m_nodes were found in.
+                    */
+                    mutable std::uint64_t m_generation {};
+
+                    /**
+                    * @brief Walks the trie again if nodes were freed since m_nodes were found.
+                    */
+                    void revalidate() const;
+
+                public:
+
+                    /**
+                    * @brief Creates an empty query on an index
+                    *
+                    * @param index index to query, must outlive the query
+                    */
+                    explicit TypeAhead(const MenuSearchIndex& index);
+
+                    /**
+                    * @brief Appends a character to the query
+                    */
+                    void push(char c);
+
+                    /**
+                    * @brief Removes the last character of the query
+                    */
+                    void pop();
+
+                    /**
+                    * @brief Empties the query
+                    */
+                    void clear();
+
+                    /**
+                    * @brief Returns the typed text
+                    */
+                    std::string_view getText() const;
+
+                    /**
+                    * @brief Collects items matching the typed text
+                    *
+                    * @param out receives the hits, cleared first
+                    * @param maxResults maximal count of hits
+                    */
+                    void results(std::vector<SearchHit>& out, std::size_t maxResults = 20) const;
+            };
+
+        private:
+
+            static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+            /**
+            * @brief Trie node, children form a singly linked sibling list.
+            */
+            struct Node{
+                std::uint32_t firstChild;
+                std::uint32_t nextSibling;
+                char key;
+                std::vector<IMenuItem*> items;
+            };
+
+            MenuPage* m_root;
+
+            /**
+            * @brief Taken shared by queries, exclusively by the observer callbacks.
+            */
+            mutable std::shared_mutex m_mutex {};
+
+            /**
+            * @brief Trie nodes, index 0 is the root.
+            */
+            std::vector<Node> m_nodes {};
+
+            /**
+            * @brief Freed nodes, reused before m_nodes grows.
+            */
+            std::vector<std::uint32_t> m_freeNodes {};
+
+            /**
+            * @brief Bumped whenever a node is freed, so TypeAhead knows its positions may be stale.
+            */
+            std::uint64_t m_generation {};
+
+            /**
+            * @brief Lower-cased label each item is currently indexed under.
+            */
+            std::unordered_map<const IMenuItem*, std::string> m_labels {};
+
+            std::uint32_t findChild(std::uint32_t node, char key) const;
+            std::uint32_t findOrAddChild(std::uint32_t node, char key);
+
+            /**
+            * @brief Walks the trie along a key, npos if it is not present.
+            */
+            std::uint32_t walk(std::uint32_t node, std::string_view key) const;
+
+            /**
+            * @brief Drops an item from the node of a key and frees the nodes left empty.
+            */
+            void eraseKey(std::string_view key, const IMenuItem* item);
+
+            void insertItem(IMenuItem* item);
+            void eraseItem(const IMenuItem* item);
+            void insertSubtree(IMenuItem* item);
+            void eraseSubtree(const IMenuItem* item);
+
+            /**
+            * @brief Calls f(key) for the trie key of every word in a lower-cased label.
+            */
+            template <typename F>
+            static void forEachKey(std::string_view label, F f);
+
+            /**
+            * @brief Returns the part of a query looked up in the trie, its first word up to MaxDepth.
+            */
+            static std::string_view trieKey(std::string_view query);
+
+            /**
+            * @brief Tells whether a word of a lower-cased label starts with the query.
+            */
+            static bool matchesWord(std::string_view label, std::string_view query);
+
+            void collect(std::uint32_t node, std::string_view query,
+                         std::vector<SearchHit>& out, std::size_t maxResults) const;
+
+        public:
+
+            /**
+            * @brief Indexes a menu tree and starts following its changes
+            *
+            * @param root pointer to the root menu page
+            */
+            explicit MenuSearchIndex(MenuPage* root);
+
+            /**
+            * @brief Detaches from the root page
+            */
+            ~MenuSearchIndex() override;
+
+            MenuSearchIndex(const MenuSearchIndex&) = delete;
+            MenuSearchIndex& operator=(const MenuSearchIndex&) = delete;
+
+            /**
+            * @brief Finds items with a label word starting with the query
+            *
+            * @param query typed text, case-insensitive
+            * @param maxResults maximal count of hits
+            * @return matching items and their pages
+            */
+            std::vector<SearchHit> query(std::string_view query, std::size_t maxResults = 20) const;
+
+            /**
+            * @brief Finds items with a label word starting with the query, reusing the output vector
+            *
+            * @param query typed text, case-insensitive
+            * @param out receives the hits, cleared first
+            * @param maxResults maximal count of hits
+            */
+            void query(std::string_view query, std::vector<SearchHit>& out, std::size_t maxResults = 20) const;
+
+            /**
+            * @brief Returns pages from the root down to the page holding an item
+            *
+            * @param item indexed item
+            * @return page path, root first
+            */
+            std::vector<MenuPage*> getPagePath(const IMenuItem* item) const;
+
+            /**
+            * @brief Returns count of indexed items
+            */
+            std::size_t getCount() const;
+
+            void onItemAdded(MenuPage* page, IMenuItem* item) override;
+            void onItemRemoved(MenuPage* page, IMenuItem* item) override;
+            void onLabelChanged(IMenuItem* item) override;
+    };
+}
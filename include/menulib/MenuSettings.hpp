@@ -0,0 +1,169 @@
+#pragma once
+#include "IMenuObserver.hpp"
+#include "MenuPage.hpp"
+#include "MenuPaths.hpp"
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mr{
+
+    /**
+    * @brief Saves and restores toggle and slider values of a menu tree.
+    *
+    * Every stateful item is identified by its key: the base labels of the pages
+    * leading to it and its own, joined with '/' ("Settings/Audio/Volume"); a label
+    * repeated among siblings gets "#2", "#3"... appended. '/', '#' and '\' in labels
+    * are escaped with '\'. Keys are kept by MenuPaths: when an item is removed or
+    * relabelled, the siblings whose "#n" changed are re-keyed and keep their values,
+    * which the next save stores under the new keys.
+    *
+    * The store attaches itself as an observer of the root and remembers which items
+    * changed since the last save. save() appends only those values to a journal
+    * file, one checksummed line per value, and fsyncs it. Once the journal holds
+    * more stale lines than the compaction threshold it is rewritten into a
+    * temporary file which atomically replaces the journal. A torn or corrupted
+    * tail left by a crash is detected by its checksum and cut off on load.
+    *
+    * Values of keys not present in the tree are kept, so settings of items added
+    * later or on lazy pages survive. Values and the tree may change on any thread.
+    * The store's state is guarded by MenuPage::ObserverLock, which its callbacks
+    * already run under; every public member takes it, so they are callable from
+    * any thread, and load() runs the item callbacks of restored values with it held.
+    */
+    class MenuSettings : public IMenuObserver, private MenuPaths::Listener{
+        private:
+            MenuPage* m_root {};
+            std::string m_path {};
+            std::size_t m_compactThreshold {};
+
+            /**
+            * @brief Key of every item in the tree.
+            */
+            MenuPaths m_paths;
+
+            /**
+            * @brief Stateful item of every key in the tree.
+            */
+            std::unordered_map<std::string, IMenuItem*> m_items {};
+
+            /**
+            * @brief Values as persisted in the journal, by key.
+            */
+            std::map<std::string, std::string> m_saved {};
+
+            /**
+            * @brief Count of value lines in the journal, stale ones included.
+            */
+            std::size_t m_journalRecords {};
+
+            mutable std::mutex m_dirtyMutex {};
+            std::unordered_set<const IMenuItem*> m_dirty {};
+
+            /**
+            * @brief Set once the journal was read, by load() or before the first write.
+            */
+            bool m_read {};
+
+            /**
+            * @brief Reads the journal into m_saved, cutting off a damaged tail
+            *
+            * @return false if there is no journal yet
+            * @throws std::runtime_error if the file is not a settings journal
+            */
+            bool readJournal();
+
+            void pathAdded(const MenuPaths::Node& node, bool renamed) override;
+            void pathRemoved(const MenuPaths::Node& node, bool renamed) override;
+
+            /**
+            * @brief Returns the persisted form of an item's value.
+            */
+            static std::string valueOf(const IMenuItem* item);
+
+            /**
+            * @brief Applies a persisted value, false if it cannot be parsed.
+            */
+            static bool apply(IMenuItem* item, std::string_view value);
+
+        public:
+
+            /**
+            * @brief Parametric Menu Settings constructor
+            *
+            * Indexes the tree and starts tracking changes, nothing is read yet.
+            *
+            * @param root root page of the tree, must outlive the store
+            * @param path journal file
+            * @param compactThreshold count of stale journal lines tolerated before compacting
+            */
+            MenuSettings(MenuPage* root, std::string path, std::size_t compactThreshold = 256);
+
+            /**
+            * @brief Detaches from the root, unsaved changes are lost
+            */
+            ~MenuSettings() override;
+
+            MenuSettings(const MenuSettings&) = delete;
+            MenuSettings& operator=(const MenuSettings&) = delete;
+
+            /**
+            * @brief Reads the journal and applies its values to the tree
+            *
+            * Item callbacks run for applied values. A missing file is not an error.
+            *
+            * @return count of values applied to items
+            * @throws std::runtime_error if the file is not a settings journal
+            */
+            std::size_t load();
+
+            /**
+            * @brief Appends the values changed since the last save
+            *
+            * Reads the journal first if load() has not run, so compaction keeps its values.
+            * A failed write is cut off the journal again and its values stay dirty.
+            *
+            * @return count of values written
+            * @throws std::runtime_error if the journal cannot be written
+            */
+            std::size_t save();
+
+            /**
+            * @brief Rewrites the journal with one line per key
+            *
+            * Reads the journal first if load() has not run, so its values are kept.
+            *
+            * @throws std::runtime_error if the journal cannot be written
+            */
+            void compact();
+
+            /**
+            * @brief Returns key of a stateful item, empty if the item is not tracked
+            */
+            std::string getKey(const IMenuItem* item) const;
+
+            /**
+            * @brief Returns item of a key, nullptr if no tracked item has it
+            */
+            IMenuItem* find(std::string_view key) const;
+
+            /**
+            * @brief Returns count of items changed since the last save
+            */
+            std::size_t getDirtyCount() const;
+
+            /**
+            * @brief Returns count of value lines in the journal, stale ones included
+            */
+            std::size_t getJournalRecords() const;
+
+            void onItemAdded(MenuPage* page, IMenuItem* item) override;
+            void onItemRemoved(MenuPage* page, IMenuItem* item) override;
+            void onLabelChanged(IMenuItem* item) override;
+            void onValueChanged(IMenuItem* item) override;
+    };
+}
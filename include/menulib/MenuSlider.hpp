@@ -1,52 +1,127 @@
 #pragma once
-#include "IMenuItem.hpp"
+#include "IMenuSlider.hpp"
+#include "InplaceFunction.hpp"
+#include "MenuStats.hpp"
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
-#include <functional>
+#include <utility>
 
 namespace mr {
     /**
     * @brief Template Menu Slider item class.
     *
     * Handles value incrementing and decrementing for numeric types (int, float, double, etc.)
+    *
+    * Value, bounds and step are atomics: any thread may read them lock-free and change
+    * the value with setValue() without blocking readers. The attached function runs on
+    * the thread that made the change. The label is composed by appendLabel() or
+    * getLabel() on the UI thread that renders the menu.
+    *
     * @tparam T Numeric type to be controlled (e.g. int, float, double)
     */
     template <typename T>
-    class MenuSlider : public IMenuItem {
+    class MenuSlider : public IMenuSlider {
         static_assert(std::is_arithmetic<T>::value, "MenuSlider: can only be used with numeric types.");
 
         private:
             /**
             * @brief Current value
             */
-            T m_value;
+            std::atomic<T> m_value;
             /**
             * @brief Minimum value possible to set
             */
-            T m_min;
+            std::atomic<T> m_min;
             /**
             * @brief Maximum value possible to set
             */
-            T m_max;
+            std::atomic<T> m_max;
             /**
             * @brief Step with which the value increments or decrements
             */
-            T m_step;
+            std::atomic<T> m_step;
             /**
-            * @brief Base display label without respect to value
+            * @brief Function attached for the item to execute passing the value
             */
-            std::string m_baseLabel;
+            MenuCallback<void(T)> m_func;
             /**
-            * @brief Function attached for the item to execute passing the value
+            * @brief Format used for floating point values
             */
-            std::function<void(T)> m_func;
+            std::chars_format m_format {std::chars_format::general};
             /**
-            * @brief helper function to set full label with baseLabel and current value
+            * @brief Precision used for floating point values, negative for shortest round-trip output
             */
-            void updateLabel() {
-                std::string name = m_baseLabel + " < " + std::to_string(m_value) + " >";
-                IMenuItem::setLabel(name);
+            int m_precision {-1};
+            /**
+            * @brief Display label returned by getLabel(), created on its first call
+            */
+            mutable std::unique_ptr<std::string> m_labelCache {};
+
+            /**
+            * @brief helper function appending a value in the form " < value >"
+            *
+            * The value is written with std::to_chars into a stack buffer first.
+            *
+            * @param out line to append to
+            * @param value value to print
+            */
+            void appendValue(std::string& out, T value) const {
+                char buffer[128];
+                char* end = buffer + sizeof(buffer);
+                std::to_chars_result result {};
+
+                if constexpr (std::is_same<T, bool>::value){
+                    result = std::to_chars(buffer, end, static_cast<int>(value));
+                }
+                else if constexpr (std::is_floating_point<T>::value){
+                    result = m_precision < 0 ? std::to_chars(buffer, end, value, m_format)
+                                             : std::to_chars(buffer, end, value, m_format, m_precision);
+                    if(result.ec != std::errc{}){
+                        // fixed output of a huge value does not fit, scientific always does
+                        result = std::to_chars(buffer, end, value, std::chars_format::scientific);
+                    }
+                }
+                else{
+                    result = std::to_chars(buffer, end, value);
+                }
+
+                out += " < ";
+                out.append(buffer, result.ptr);
+                out += " >";
+            }
+
+            /**
+            * @brief helper function publishing a new value computed from the current one
+            *
+            * Retries if another thread changed the value meanwhile. If the value changed,
+            * observers are notified and the attached function runs once.
+            *
+            * @param next function computing the new value from the current one
+            */
+            template <typename F>
+            void update(F next){
+                T current = m_value.load();
+                T value = next(current);
+
+                while (value != current && !m_value.compare_exchange_weak(current, value)){
+                    value = next(current);
+                }
+
+                if (value != current){
+                    notifyValueChanged();
+                    if (m_func){
+                        MENULIB_INSTRUMENT(this, Callback);
+                        m_func(value);
+                    }
+                }
             }
 
         public:
@@ -57,14 +132,14 @@ namespace mr {
             * Creates an instance with given label, default constrains, steps and no function
             *
             * @param label Display text label
+            * @param resource memory resource used for the labels
             */
-            MenuSlider(const std::string& label)
-                : IMenuItem(label), m_baseLabel(label), m_value(0), m_min(0), m_max(100), m_step(1), m_func(nullptr)
+            MenuSlider(std::string_view label, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : IMenuSlider(label, resource), m_value(0), m_min(0), m_max(100), m_step(1), m_func(nullptr)
             {
                 if(label.empty()){
                     throw std::invalid_argument("MenuSlider: Label cannot be empty");
                 }
-                updateLabel();
             }
 
             /**
@@ -79,15 +154,17 @@ namespace mr {
             * @param max maximum value constrain
             * @param step step size
             * @param func Function to execute when selected
+            * @param resource memory resource used for the labels
             */
-            MenuSlider(const std::string& label, T val, T min,
-                       T max, T step,const std::function<void(T)>& func)
-                :IMenuItem(label), m_baseLabel(label), m_value(val), m_min(min), m_max(max), m_step(step), m_func(func)
+            MenuSlider(std::string_view label, T val, T min,
+                       T max, T step, MenuCallback<void(T)> func,
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                :IMenuSlider(label, resource), m_value(val), m_min(min), m_max(max), m_step(step), m_func(std::move(func))
             {
                 if(label.empty()){
                     throw std::invalid_argument("MenuSlider: Label cannot be empty");
                 }
-                if(!func){
+                if(!m_func){
                     throw std::invalid_argument("MenuSlider: Function cannot be null");
                 }
                 if(min >= max){
@@ -99,7 +176,28 @@ namespace mr {
                 if(step <= 0) {
                     throw std::invalid_argument("MenuSlider: Step must be positive integer");
                 }
-                updateLabel();
+            }
+
+            /**
+            * @brief Appends the label with the current value, "base < value >"
+            *
+            * @param out line to append to
+            */
+            void appendLabel(std::string& out) const override{
+                std::string_view base = getBaseLabel();
+                out.append(base.data(), base.size());
+                appendValue(out, m_value.load());
+            }
+
+            /**
+            * @brief Returns display label with the current value
+            *
+            * Composed into a buffer owned by the item, call it from the UI thread only.
+            *
+            * @return label in the form "base < value >"
+            */
+            std::string_view getLabel() const override{
+                return composeLabel(m_labelCache);
             }
 
             /**
@@ -125,13 +223,7 @@ namespace mr {
             * @param navigator Pointer to the menu navigator
             */
             void onLeft(MenuNavigator* navigator) override{
-                if (m_value - m_step >= m_min){
-                    m_value -= m_step;
-                    updateLabel();
-                    if (m_func){
-                        m_func(m_value);
-                    }
-                }
+                onStep(navigator, -1);
             }
             /**
             * @brief increment current value
@@ -139,25 +231,49 @@ namespace mr {
             * @param navigator Pointer to the menu navigator
             */
             void onRight(MenuNavigator* navigator) override{
-                if (m_value + m_step <= m_max){
-                    m_value += m_step;
-                    updateLabel();
-                    if (m_func){
-                        m_func(m_value);
+                onStep(navigator, 1);
+            }
+
+            /**
+            * @brief moves the value by several steps, executing the attached function once
+            *
+            * Stops at the bounds exactly like repeated onLeft()/onRight() calls would.
+            *
+            * @param navigator Pointer to the menu navigator
+            * @param steps count of steps, negative to decrement
+            */
+            void onStep(MenuNavigator* navigator, int steps) override{
+                T min = m_min.load();
+                T max = m_max.load();
+                T step = m_step.load();
+
+                // the bounds are moved by one step instead of the value, value + step overflows near the type's limits
+                bool canDecrease = min <= std::numeric_limits<T>::max() - step;
+                bool canIncrease = max >= std::numeric_limits<T>::lowest() + step;
+
+                update([=](T value){
+                    int remaining = steps;
+                    for(; remaining < 0 && canDecrease && value >= min + step; ++remaining){
+                        value -= step;
                     }
-                }
+                    for(; remaining > 0 && canIncrease && value <= max - step; --remaining){
+                        value += step;
+                    }
+                    return value;
+                });
             }
 
             /**
-            * @brief sets display label with respect to current value
+            * @brief sets how floating point values are printed in the label
             *
-            * @param label new display label to set
+            * Has no effect on integral sliders.
+            *
+            * @param format std::chars_format used for the value
+            * @param precision digits of precision, negative for the shortest exact representation
             */
-            void setLabel(const std::string& label) override{
-                if(!label.empty()){
-                    m_baseLabel = label;
-                    updateLabel();
-                }
+            void setFormat(std::chars_format format, int precision = -1){
+                m_format = format;
+                m_precision = precision;
             }
 
             /**
@@ -166,7 +282,7 @@ namespace mr {
             * @param min new minimum value
             */
             void setMin(T min){
-                if(min >= m_max)
+                if(min >= m_max.load())
                 {
                     return;
                 }
@@ -174,11 +290,9 @@ namespace mr {
                 m_min = min;
 
                 // auto-correct value if it is now out of bounds, clamp it to the min
-                if(m_value < min)
-                {
-                    m_value = min;
-                    updateLabel();
-                }
+                update([min](T value){
+                    return value < min ? min : value;
+                });
             }
 
             /**
@@ -187,7 +301,7 @@ namespace mr {
             * @param max new maximum value
             */
             void setMax(T max){
-                if(max <= m_min)
+                if(max <= m_min.load())
                 {
                     return;
                 }
@@ -195,11 +309,9 @@ namespace mr {
                 m_max = max;
 
                 // auto-correct value if it is now out of bounds, clamp it to the max
-                if(m_value > max)
-                {
-                    m_value = max;
-                    updateLabel();
-                }
+                update([max](T value){
+                    return value > max ? max : value;
+                });
             }
 
             /**
@@ -216,28 +328,103 @@ namespace mr {
                 m_step = step;
             }
 
+            /**
+            * @brief Returns current value
+            */
+            T getValue() const{
+                return m_value.load();
+            }
+
+            /**
+            * @brief Returns minimum value possible to set
+            */
+            T getMin() const{
+                return m_min.load();
+            }
+
+            /**
+            * @brief Returns maximum value possible to set
+            */
+            T getMax() const{
+                return m_max.load();
+            }
+
+            /**
+            * @brief Returns step the value increments or decrements by
+            */
+            T getStep() const{
+                return m_step.load();
+            }
+
+            double getNumericValue() const override{
+                return static_cast<double>(m_value.load());
+            }
+
+            double getNumericMin() const override{
+                return static_cast<double>(m_min.load());
+            }
+
+            double getNumericMax() const override{
+                return static_cast<double>(m_max.load());
+            }
+
+            double getNumericStep() const override{
+                return static_cast<double>(m_step.load());
+            }
+
+            void setNumericValue(double value) override{
+                if (std::isnan(value)){
+                    return;
+                }
+                if constexpr (std::is_integral<T>::value){
+                    value = std::round(value);
+                }
+
+                // clamped while still a double, converting a value outside T is undefined
+                T min = m_min.load();
+                T max = m_max.load();
+                if (value <= static_cast<double>(min)){
+                    setValue(min);
+                }
+                else if (value >= static_cast<double>(max)){
+                    setValue(max);
+                }
+                else{
+                    setValue(static_cast<T>(value));
+                }
+            }
+
+            bool isIntegral() const override{
+                return std::is_integral<T>::value;
+            }
+
             /**
             * @brief sets current value the slider has
             *
-            * @param value new value
+            * Safe to call from any thread.
+            *
+            * @param value new value, clamped to the bounds; NaN is ignored
             */
             void setValue(T value){
+                if constexpr (std::is_floating_point<T>::value){
+                    if (std::isnan(value)){
+                        return;
+                    }
+                }
+                T min = m_min.load();
+                T max = m_max.load();
 
                 // clamping between bounds of max and min
-                if (value < m_min){
-                    value = m_min;
+                if (value < min){
+                    value = min;
                 }
-                if (value > m_max){
-                    value = m_max;
+                if (value > max){
+                    value = max;
                 }
 
-                if (m_value != value) {
-                    m_value = value;
-                    updateLabel();
-                    if (m_func){
-                        m_func(m_value);
-                    }
-                }
+                update([value](T){
+                    return value;
+                });
             }
     };
 }
@@ -0,0 +1,234 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+* @brief Enables the instrumentation hooks of the library when defined to 1.
+*
+* Set it with the MENULIB_INSTRUMENTATION CMake option, so the library and its
+* users agree. When it is 0 the hooks expand to nothing.
+*/
+#ifndef MENULIB_INSTRUMENTATION
+#define MENULIB_INSTRUMENTATION 0
+#endif
+
+namespace mr{
+
+    class IMenuItem;
+
+    /**
+    * @brief Per-item call counts and latency histograms of menu actions.
+    *
+    * Every thread records into its own table, written by that thread alone with
+    * relaxed atomic stores, so the hot path takes no lock and does not allocate.
+    * A thread's table is allocated on its first record and an item's slot is
+    * claimed on its first record on that thread; both take a lock once. A
+    * thread's table holds MENULIB_INSTRUMENTATION_SLOTS items, a CMake cache
+    * variable (128 by default).
+    * snapshot() sums the tables of all threads, tables of exited threads are
+    * merged into it when the thread ends.
+    *
+    * Latencies go into log2 buckets: bucket 0 counts calls under 1 ns and bucket
+    * i calls of [2^(i-1), 2^i) ns, the last bucket being open-ended.
+    *
+    * The library records navigator actions and item callbacks through
+    * MENULIB_INSTRUMENT when built with MENULIB_INSTRUMENTATION; custom items
+    * can use the same macro or Scope.
+    */
+    class MenuStats{
+        public:
+
+            /**
+            * @brief Recorded actions
+            */
+            enum class Event : std::uint8_t{
+                Select,     ///< MenuNavigator::select() on the item
+                Left,       ///< MenuNavigator::left() on the item, or a negative step()
+                Right,      ///< MenuNavigator::right() on the item, or a positive step()
+                Back,       ///< MenuNavigator::back() leaving the page
+                Callback    ///< the item's attached function
+            };
+
+            static constexpr std::size_t EventCount = 5;
+            static constexpr std::size_t BucketCount = 32;
+
+            /**
+            * @brief Statistics of one event of one item
+            */
+            struct EventStats{
+                std::uint64_t count {};
+                std::uint64_t totalNs {};
+                std::uint64_t maxNs {};
+                std::uint64_t buckets[BucketCount] {};
+
+                /**
+                * @brief Returns the upper bound of the bucket holding the given quantile
+                *
+                * @param quantile 0 to 1, e.g. 0.99
+                * @return latency in ns, at most maxNs
+                */
+                std::uint64_t quantileNs(double quantile) const;
+            };
+
+            /**
+            * @brief Statistics of one item, summed over all threads
+            */
+            struct ItemStats{
+                /**
+                * @brief Address of the item, only meaningful while it exists
+                */
+                const IMenuItem* item {};
+                /**
+                * @brief Base label of the item when it was first recorded
+                *
+                * Statistics follow the item, not its label: they are not split by setLabel().
+                */
+                std::string label {};
+                EventStats events[EventCount] {};
+
+                /**
+                * @brief Returns count of all recorded events
+                */
+                std::uint64_t totalCount() const;
+            };
+
+            /**
+            * @brief Aggregated statistics at one point in time
+            */
+            struct Snapshot{
+                /**
+                * @brief Items ordered by their count of events, most used first
+                */
+                std::vector<ItemStats> items {};
+                /**
+                * @brief Records lost because a thread's table was full
+                */
+                std::uint64_t dropped {};
+
+                /**
+                * @brief Formats the statistics as an aligned table, latencies in microseconds
+                */
+                std::string toText() const;
+
+                /**
+                * @brief Formats the statistics as a JSON document, latencies in nanoseconds
+                */
+                std::string toJson() const;
+            };
+
+            /**
+            * @brief Counters of one item in a thread's table
+            */
+            struct Counters;
+
+            /**
+            * @brief Times an event from construction to destruction
+            *
+            * The item's counters are looked up at construction, so the item may go
+            * away while the event runs. A scope covering several events, e.g. a
+            * coalesced MenuNavigator::step(), counts each of them and records the
+            * average latency.
+            */
+            class Scope{
+                private:
+                    Counters* m_counters;
+                    Event m_event;
+                    std::uint64_t m_count;
+                    std::chrono::steady_clock::time_point m_start;
+
+                public:
+                    /**
+                    * @param item item the event belongs to, nullptr records nothing
+                    * @param event recorded event
+                    * @param count count of events the scope covers, 0 records nothing
+                    */
+                    Scope(const IMenuItem* item, Event event, std::uint64_t count = 1) noexcept
+                        : m_counters(count != 0 ? MenuStats::counters(item) : nullptr), m_event(event), m_count(count),
+                          m_start(m_counters ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}) {}
+
+                    ~Scope(){
+                        if(m_counters){
+                            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - m_start;
+                            MenuStats::add(m_counters, m_event, static_cast<std::uint64_t>(elapsed.count()), m_count);
+                        }
+                    }
+
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+            };
+
+            /**
+            * @brief Records events with a measured latency
+            *
+            * @param item item the events belong to, nullptr records nothing
+            * @param event recorded event
+            * @param ns latency of all events together in nanoseconds
+            * @param count count of events, each recorded with the average latency
+            */
+            static void record(const IMenuItem* item, Event event, std::uint64_t ns, std::uint64_t count = 1) noexcept;
+
+            /**
+            * @brief Sums the statistics of all threads
+            */
+            static Snapshot snapshot();
+
+            /**
+            * @brief Discards all statistics recorded so far
+            *
+            * Each thread drops its own table on its next record.
+            */
+            static void reset();
+
+            /**
+            * @brief Returns name of an event as used in the exports
+            */
+            static const char* eventName(Event event);
+
+        private:
+
+            /**
+            * @brief Returns the calling thread's counters of an item, claiming a slot if needed
+            *
+            * @return counters, nullptr for a null item or a full table
+            */
+            static Counters* counters(const IMenuItem* item) noexcept;
+
+            static void add(Counters* counters, Event event, std::uint64_t ns, std::uint64_t count) noexcept;
+    };
+}
+
+/**
+* @brief Times the rest of the enclosing scope as an event of an item.
+*
+* Expands to nothing unless MENULIB_INSTRUMENTATION is 1. Use it once per scope.
+*
+* @param item item the event belongs to
+* @param event name of a MenuStats::Event enumerator, e.g. Select
+*/
+#if MENULIB_INSTRUMENTATION
+#define MENULIB_INSTRUMENT(item, event) \
+    ::mr::MenuStats::Scope menulibInstrumentScope((item), ::mr::MenuStats::Event::event)
+#else
+#define MENULIB_INSTRUMENT(item, event) ((void)0)
+#endif
+
+/**
+* @brief Times the rest of the enclosing scope as |steps| left or right events of an item.
+*
+* Negative steps count as Left, positive as Right, 0 records nothing. Expands to
+* nothing unless MENULIB_INSTRUMENTATION is 1. Use it once per scope.
+*
+* @param item item the events belong to
+* @param steps signed count of moves, as passed to MenuNavigator::step()
+*/
+#if MENULIB_INSTRUMENTATION
+#define MENULIB_INSTRUMENT_STEPS(item, steps) \
+    ::mr::MenuStats::Scope menulibInstrumentScope((item), \
+        (steps) < 0 ? ::mr::MenuStats::Event::Left : ::mr::MenuStats::Event::Right, \
+        (steps) < 0 ? 0 - static_cast<std::uint64_t>(steps) : static_cast<std::uint64_t>(steps))
+#else
+#define MENULIB_INSTRUMENT_STEPS(item, steps) ((void)0)
+#endif
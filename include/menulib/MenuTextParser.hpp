@@ -0,0 +1,85 @@
+#pragma once
+#include "MenuPage.hpp"
+#include "MenuActionRegistry.hpp"
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace mr{
+
+    /**
+    * @brief Error in a text menu definition, with the position it was found at.
+    */
+    class MenuParseError : public std::runtime_error{
+        private:
+            std::size_t m_line;
+            std::size_t m_column;
+
+        public:
+
+            /**
+            * @brief Creates the error
+            *
+            * @param line 1-based line
+            * @param column 1-based column, in bytes
+            * @param message what is wrong
+            */
+            MenuParseError(std::size_t line, std::size_t column, const std::string& message);
+
+            /**
+            * @brief Returns the 1-based line of the error
+            */
+            std::size_t getLine() const;
+
+            /**
+            * @brief Returns the 1-based column of the error, in bytes
+            */
+            std::size_t getColumn() const;
+    };
+
+    /**
+    * @brief Builds a menu tree from a JSON definition in a single streaming pass.
+    *
+    * The document is read in fixed-size chunks and items are created as their
+    * objects close, no document tree is kept. The root object is a page:
+    *
+    *     {"label": "Main Menu", "items": [
+    *         {"type": "option", "label": "Start Game", "action": "start"},
+    *         {"type": "toggle", "label": "Sound", "state": true, "action": "sound"},
+    *         {"type": "slider", "label": "Volume", "numeric": "int",
+    *          "value": 50, "min": 0, "max": 100, "step": 5, "action": "volume"},
+    *         {"type": "page", "label": "Settings", "items": [ ... ]}
+    *     ]}
+    *
+    * "numeric" is one of "int" (default), "float" or "double". Actions are bound
+    * through a MenuActionRegistry, a name it does not know is an error. Unknown
+    * keys, missing fields and invalid ranges are reported with their position.
+    */
+    class MenuTextParser{
+        private:
+            const MenuActionRegistry* m_registry {};
+            std::size_t m_maxDepth {};
+
+        public:
+
+            /**
+            * @brief Parametric Menu Text Parser constructor
+            *
+            * @param registry callbacks bound by name, nullptr to ignore actions,
+            *                 must outlive the parsed items
+            * @param maxDepth deepest allowed page nesting
+            */
+            explicit MenuTextParser(const MenuActionRegistry* registry = nullptr, std::size_t maxDepth = 64);
+
+            /**
+            * @brief Parses a definition
+            *
+            * @param input stream positioned at the definition
+            * @return root page, owning the whole tree
+            * @throws MenuParseError if the definition is malformed
+            */
+            std::unique_ptr<MenuPage> parse(std::istream& input) const;
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Fixed-size pool of worker threads running menu actions.
+    *
+    * Tasks run in submission order on whichever worker is free. Tasks still queued
+    * when the pool is destroyed are run before the workers are joined.
+    */
+    class MenuThreadPool{
+        private:
+            std::vector<std::thread> m_workers {};
+            std::deque<std::function<void()>> m_tasks {};
+            std::mutex m_mutex {};
+            std::condition_variable m_wake {};
+            bool m_stopping {};
+
+            /**
+            * @brief Worker loop taking tasks until the pool stops.
+            */
+            void work();
+
+            /**
+            * @brief Lets the workers finish the queued tasks and joins them.
+            */
+            void stop();
+
+        public:
+
+            /**
+            * @brief Starts the workers
+            *
+            * @param threads count of worker threads, at least one
+            * @throws std::system_error if a thread cannot be started, after the started ones are joined
+            */
+            explicit MenuThreadPool(std::size_t threads = 2);
+
+            /**
+            * @brief Runs remaining tasks and joins the workers
+            */
+            ~MenuThreadPool();
+
+            MenuThreadPool(const MenuThreadPool&) = delete;
+            MenuThreadPool& operator=(const MenuThreadPool&) = delete;
+
+            /**
+            * @brief Queues a task
+            *
+            * @param task function to run on a worker thread
+            */
+            void submit(std::function<void()> task);
+
+            /**
+            * @brief Returns count of worker threads
+            */
+            std::size_t getThreadCount() const;
+    };
+}
@@ -1,7 +1,11 @@
 #pragma once
 #include "IMenuItem.hpp"
+#include "InplaceFunction.hpp"
+#include <atomic>
+#include <memory_resource>
 #include <stdexcept>
-#include <functional>
+#include <string>
+#include <string_view>
 
 
 namespace mr{
@@ -9,29 +13,25 @@ namespace mr{
     * @brief Menu Toggle item class.
     *
     * Menu toggle item is a class for elements which handle value toggling functionality
+    *
+    * The state is an atomic: any thread may read it lock-free or change it with setState().
+    * The attached function runs on the thread that made the change, while the label is
+    * only built inside getLabel() on the UI thread.
     */
     class MenuToggle : public IMenuItem{
         private:
             /**
             * @brief State of the toggle element
             */
-            bool m_state;
-            /**
-            * @brief Display label of the menu item.
-            */
-            std::string m_baseLabel;
+            std::atomic<bool> m_state;
             /**
             * @brief Function attached for the item to execute passing the toggled bool
             */
-            std::function<void(bool)> m_func {};
-
+            MenuCallback<void(bool)> m_func {};
             /**
-            * @brief updates main label which is displayed by adding state to base name
+            * @brief Display label returned by getLabel(), created on its first call
             */
-            void updateLabel(){
-                std::string name = m_baseLabel + (m_state ? " [ON]" : " [OFF]");
-                IMenuItem::setLabel(name);
-            }
+            mutable std::unique_ptr<std::string> m_labelCache {};
         public:
 
             /**
@@ -41,8 +41,10 @@ namespace mr{
             *
             * @param label Display text label
             * @param initialState initial state of controlled bool
+            * @param resource memory resource used for the labels
             */
-            MenuToggle(const std::string& label, bool initialState);
+            MenuToggle(std::string_view label, bool initialState,
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
             /**
             * @brief Parametric constructor
@@ -52,8 +54,10 @@ namespace mr{
             * @param label Display text label
             * @param initialState initial state of controlled bool
             * @param func Function to execute when selected
+            * @param resource memory resource used for the labels
             */
-            MenuToggle(const std::string& label, bool initialState, const std::function<void(bool)>& func);
+            MenuToggle(std::string_view label, bool initialState, MenuCallback<void(bool)> func,
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
             /**
             * @brief Indicates whether this item represents a terminal menu entry.
@@ -63,6 +67,13 @@ namespace mr{
             */
             bool isEnd() const override;
 
+            /**
+            * @brief Returns the category of this item.
+            *
+            * @return ItemKind::Toggle
+            */
+            ItemKind getKind() const override;
+
             /**
             * @brief When selected toggles state, and executes held fuction with the new state
             *
@@ -71,11 +82,36 @@ namespace mr{
             void onSelect(MenuNavigator* navigator) override;
 
             /**
-            * @brief updates display label with respect to the current state
+            * @brief Appends the label with the current state, "base [ON]" or "base [OFF]"
+            *
+            * @param out line to append to
+            */
+            void appendLabel(std::string& out) const override;
+
+            /**
+            * @brief Returns display label with the current state
+            *
+            * Composed into a buffer owned by the item, call it from the UI thread only.
+            *
+            * @return label in the form "base [ON]" or "base [OFF]"
+            */
+            std::string_view getLabel() const override;
+
+            /**
+            * @brief Returns the current state
+            *
+            * @return true if the toggle is on
+            */
+            bool getState() const;
+
+            /**
+            * @brief sets the state, executing held function if it changed
+            *
+            * Safe to call from any thread.
             *
-            * @param label new display label to set
+            * @param state new state
             */
-            void setLabel(const std::string& label) override;
+            void setState(bool state);
 
     };
 }
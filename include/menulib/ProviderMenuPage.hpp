@@ -0,0 +1,141 @@
+#pragma once
+#include "MenuPage.hpp"
+#include "IMenuProvider.hpp"
+#include <cstddef>
+#include <list>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Menu page whose children are created on demand by an IMenuProvider.
+    *
+    * Only the children somebody looked at are built, and at most getCapacity() of
+    * them are kept, least recently used first out. Startup cost and memory stay
+    * independent of the provider's size. Items dropped from the cache while a
+    * MenuPage::ReadGuard is alive are destroyed once the last guard is released,
+    * so the capacity should be at least the count of visible rows.
+    *
+    * Children have no identity beyond their index: a child built again after
+    * eviction is a new object. The page is lazy (isLazy()), it does not take
+    * addItem() and is meant to be used from one thread.
+    */
+    class ProviderMenuPage : public MenuPage{
+        private:
+
+            /**
+            * @brief Cached child and its index.
+            */
+            struct Entry{
+                int index;
+                IMenuItem* item;
+            };
+
+            IMenuProvider* m_provider {};
+            std::size_t m_capacity {};
+
+            /**
+            * @brief Cached children, most recently used first.
+            */
+            mutable std::list<Entry> m_cache {};
+
+            /**
+            * @brief Cache position of every cached index.
+            */
+            mutable std::unordered_map<int, std::list<Entry>::iterator> m_lookup {};
+
+            /**
+            * @brief Children dropped from the cache while guards were alive.
+            */
+            mutable std::vector<IMenuItem*> m_evicted {};
+
+            /**
+            * @brief Count of guards alive on this page.
+            */
+            mutable int m_pins {};
+
+            /**
+            * @brief Child count read when the outermost guard was taken.
+            */
+            mutable int m_pinnedCount {};
+
+            /**
+            * @brief Count of children built since construction.
+            */
+            mutable std::size_t m_createdCount {};
+
+            /**
+            * @brief Destroys evicted children.
+            */
+            void destroyEvicted() const;
+
+        protected:
+            const void* acquireItems() const override;
+            void releaseItems(const void* pin) const override;
+            int pinnedCount(const void* pin) const override;
+            IMenuItem* pinnedItem(const void* pin, int index) const override;
+            int pinnedIndexOf(const void* pin, const IMenuItem* item) const override;
+
+        public:
+
+            /**
+            * @brief Parametric Provider Menu Page constructor
+            *
+            * @param title page title
+            * @param provider source of the children, must outlive the page
+            * @param capacity count of children kept built, at least one
+            * @param parent parent page, nullptr for the root
+            * @param resource memory resource used for the label
+            */
+            ProviderMenuPage(std::string_view title, IMenuProvider* provider, std::size_t capacity,
+                             MenuPage* parent = nullptr,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+            /**
+            * @brief Destroys the page and every built child
+            */
+            ~ProviderMenuPage() override;
+
+            ProviderMenuPage(const ProviderMenuPage&) = delete;
+            ProviderMenuPage& operator=(const ProviderMenuPage&) = delete;
+
+            /**
+            * @brief Not supported, children come from the provider
+            *
+            * @throws std::logic_error always
+            */
+            void addItem(IMenuItem* item) override;
+
+            /**
+            * @brief Not supported, children come from the provider
+            *
+            * @return false
+            */
+            bool removeItem(IMenuItem* item) override;
+
+            bool isLazy() const override;
+
+            /**
+            * @brief Drops every built child, e.g. after the provider's data changed
+            */
+            void invalidate();
+
+            /**
+            * @brief Returns count of children kept built at most
+            */
+            std::size_t getCapacity() const;
+
+            /**
+            * @brief Returns count of children currently built
+            */
+            std::size_t getCachedCount() const;
+
+            /**
+            * @brief Returns count of children built since construction
+            */
+            std::size_t getCreatedCount() const;
+    };
+}
@@ -0,0 +1,697 @@
+#pragma once
+#include "IMenuItem.hpp"
+#include "MenuEvent.hpp"
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+* @brief Menus fixed at compile time.
+*
+* The tree is declared with constexpr factory functions and flattened by build()
+* into a read-only Menu of plain arrays, laid out like FrozenMenu: breadth-first
+* per page, children of every page next to each other. Labels are string views
+* of the literals and actions are plain function pointers (non-capturing lambdas
+* convert), so nothing is allocated at startup:
+*
+*     constexpr auto menu = mr::ct::build(
+*         mr::ct::page("Main Menu",
+*             mr::ct::option("Start Game", [](){ startGame(); }),
+*             mr::ct::page("Settings",
+*                 mr::ct::toggle("Sound", true, [](bool on){ setSound(on); }),
+*                 mr::ct::slider("Volume", 50, 0, 100, 5, [](int v){ setVolume(v); }))));
+*
+*     mr::ct::Navigator navigator(menu);
+*
+* The checks MenuSlider and the other items run in their constructors (empty
+* labels, min < max, value in bounds, step > 0) happen while building, so a
+* menu stored in a constexpr variable that breaks one of them does not compile.
+*/
+namespace mr::ct{
+
+    /**
+    * @brief Node index marking "no node" (e.g. the parent of the root).
+    */
+    inline constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    /**
+    * @brief Value type of a slider.
+    */
+    enum class Numeric : std::uint8_t{
+        Int,
+        Float,
+        Double
+    };
+
+    /**
+    * @brief One flattened item.
+    */
+    struct Node{
+        ItemKind kind {ItemKind::Option};
+        std::string_view label {};
+        std::uint32_t parent {npos};
+
+        /**
+        * @brief First child and count of children, pages only.
+        */
+        std::uint32_t first {};
+        std::uint32_t count {};
+
+        /**
+        * @brief Index into the option, toggle or slider table of the node's kind.
+        */
+        std::uint32_t slot {};
+    };
+
+    struct ToggleSpec{
+        bool state {};
+        void (*action)(bool) {};
+    };
+
+    struct SliderSpec{
+        Numeric numeric {Numeric::Int};
+        double value {};
+        double min {};
+        double max {};
+        double step {};
+
+        /**
+        * @brief Action of the slider's type, the other two stay null.
+        */
+        void (*onInt)(int) {};
+        void (*onFloat)(float) {};
+        void (*onDouble)(double) {};
+    };
+
+    namespace detail{
+
+        /**
+        * @brief Keeps a parameter out of template argument deduction, so lambdas convert.
+        */
+        template <typename T>
+        struct Identity{
+            using type = T;
+        };
+    }
+
+    /**
+    * @brief Declared option, see option().
+    */
+    struct Option{
+        static constexpr std::size_t nodes = 1;
+        static constexpr std::size_t options = 1;
+        static constexpr std::size_t toggles = 0;
+        static constexpr std::size_t sliders = 0;
+
+        std::string_view label;
+        void (*action)();
+    };
+
+    /**
+    * @brief Declared toggle, see toggle().
+    */
+    struct Toggle{
+        static constexpr std::size_t nodes = 1;
+        static constexpr std::size_t options = 0;
+        static constexpr std::size_t toggles = 1;
+        static constexpr std::size_t sliders = 0;
+
+        std::string_view label;
+        bool state;
+        void (*action)(bool);
+    };
+
+    /**
+    * @brief Declared slider, see slider().
+    */
+    template <typename T>
+    struct Slider{
+        static_assert(std::is_same<T, int>::value || std::is_same<T, float>::value || std::is_same<T, double>::value,
+                      "ct::slider: value type must be int, float or double");
+
+        static constexpr std::size_t nodes = 1;
+        static constexpr std::size_t options = 0;
+        static constexpr std::size_t toggles = 0;
+        static constexpr std::size_t sliders = 1;
+
+        std::string_view label;
+        T value;
+        T min;
+        T max;
+        T step;
+        void (*action)(T);
+    };
+
+    /**
+    * @brief Declared page, see page().
+    */
+    template <typename... Items>
+    struct Page{
+        static constexpr std::size_t nodes = 1 + (Items::nodes + ... + 0);
+        static constexpr std::size_t options = (Items::options + ... + 0);
+        static constexpr std::size_t toggles = (Items::toggles + ... + 0);
+        static constexpr std::size_t sliders = (Items::sliders + ... + 0);
+
+        std::string_view label;
+        std::tuple<Items...> items;
+    };
+
+    /**
+    * @brief Declares an option
+    *
+    * @param label display label
+    * @param action function run when selected, nullptr for none
+    * @throws std::invalid_argument if the label is empty (a compile error in a constant expression)
+    */
+    constexpr Option option(std::string_view label, void (*action)() = nullptr){
+        if(label.empty()){
+            throw std::invalid_argument("ct::option: Label cannot be empty");
+        }
+        return Option{label, action};
+    }
+
+    /**
+    * @brief Declares a toggle
+    *
+    * @param label display label, shown with " [ON]" or " [OFF]"
+    * @param state initial state
+    * @param action function run with the new state when flipped, nullptr for none
+    * @throws std::invalid_argument if the label is empty (a compile error in a constant expression)
+    */
+    constexpr Toggle toggle(std::string_view label, bool state, void (*action)(bool) = nullptr){
+        if(label.empty()){
+            throw std::invalid_argument("ct::toggle: Label cannot be empty");
+        }
+        return Toggle{label, state, action};
+    }
+
+    /**
+    * @brief Declares a slider
+    *
+    * @param label display label, shown with " < value >"
+    * @param value initial value
+    * @param min minimum value
+    * @param max maximum value
+    * @param step step size
+    * @param action function run with the new value when moved, nullptr for none
+    * @throws std::invalid_argument on an empty label or invalid range (a compile error in a constant expression)
+    */
+    template <typename T>
+    constexpr Slider<T> slider(std::string_view label, T value, T min, T max, T step,
+                               typename detail::Identity<void (*)(T)>::type action = nullptr){
+        if(label.empty()){
+            throw std::invalid_argument("ct::slider: Label cannot be empty");
+        }
+        if(min >= max){
+            throw std::invalid_argument("ct::slider: Max cannot be equal or less than Min");
+        }
+        if(value < min || value > max){
+            throw std::invalid_argument("ct::slider: Initial value cannot be out of bounds");
+        }
+        if(step <= 0){
+            throw std::invalid_argument("ct::slider: Step must be positive");
+        }
+        return Slider<T>{label, value, min, max, step, action};
+    }
+
+    /**
+    * @brief Declares a page
+    *
+    * @param label page title
+    * @param items declared children, in display order
+    * @throws std::invalid_argument if the label is empty (a compile error in a constant expression)
+    */
+    template <typename... Items>
+    constexpr Page<Items...> page(std::string_view label, Items... items){
+        if(label.empty()){
+            throw std::invalid_argument("ct::page: Label cannot be empty");
+        }
+        return Page<Items...>{label, std::tuple<Items...>(items...)};
+    }
+
+    namespace detail{
+        template <typename M>
+        struct Builder;
+    }
+
+    /**
+    * @brief Flattened, read-only menu made by build().
+    *
+    * Node 0 is the root page. Runtime state (toggle states, slider values) lives
+    * in the Navigator, so a Menu can sit in read-only memory.
+    */
+    template <std::size_t N, std::size_t O, std::size_t T, std::size_t S>
+    class Menu{
+        public:
+            static constexpr std::size_t nodeCount = N;
+            static constexpr std::size_t optionCount = O;
+            static constexpr std::size_t toggleCount = T;
+            static constexpr std::size_t sliderCount = S;
+
+        private:
+            template <typename M>
+            friend struct detail::Builder;
+
+            std::array<Node, N> m_nodes {};
+            std::array<void (*)(), O> m_options {};
+            std::array<ToggleSpec, T> m_toggles {};
+            std::array<SliderSpec, S> m_sliders {};
+
+        public:
+
+            /**
+            * @brief Returns count of nodes (the root included)
+            */
+            constexpr std::uint32_t getNodeCount() const{
+                return static_cast<std::uint32_t>(N);
+            }
+
+            /**
+            * @brief Returns a node
+            */
+            constexpr const Node& getNode(std::uint32_t node) const{
+                return m_nodes[node];
+            }
+
+            /**
+            * @brief Returns the kind of a node
+            */
+            constexpr ItemKind getKind(std::uint32_t node) const{
+                return m_nodes[node].kind;
+            }
+
+            /**
+            * @brief Returns the label of a node, without state
+            */
+            constexpr std::string_view getLabel(std::uint32_t node) const{
+                return m_nodes[node].label;
+            }
+
+            /**
+            * @brief Returns the parent node, npos for the root
+            */
+            constexpr std::uint32_t getParent(std::uint32_t node) const{
+                return m_nodes[node].parent;
+            }
+
+            /**
+            * @brief Returns count of children of a page node (0 for leaves)
+            */
+            constexpr std::uint32_t getChildCount(std::uint32_t node) const{
+                return m_nodes[node].count;
+            }
+
+            /**
+            * @brief Returns node index of the n-th child of a page node
+            */
+            constexpr std::uint32_t getChild(std::uint32_t node, std::uint32_t index) const{
+                return m_nodes[node].first + index;
+            }
+
+            /**
+            * @brief Returns the action of an option node
+            */
+            constexpr void (*getAction(std::uint32_t node) const)(){
+                return m_options[m_nodes[node].slot];
+            }
+
+            /**
+            * @brief Returns the declaration of a toggle node
+            */
+            constexpr const ToggleSpec& getToggle(std::uint32_t node) const{
+                return m_toggles[m_nodes[node].slot];
+            }
+
+            /**
+            * @brief Returns the declaration of a slider node
+            */
+            constexpr const SliderSpec& getSlider(std::uint32_t node) const{
+                return m_sliders[m_nodes[node].slot];
+            }
+    };
+
+    namespace detail{
+
+        /**
+        * @brief Lays a declared tree out, reserving each page's child block before descending.
+        */
+        template <typename M>
+        struct Builder{
+            M menu {};
+            std::uint32_t next {1};
+            std::uint32_t options {};
+            std::uint32_t toggles {};
+            std::uint32_t sliders {};
+
+            constexpr void place(const Option& item, std::uint32_t self, std::uint32_t parent){
+                menu.m_nodes[self] = Node{ItemKind::Option, item.label, parent, 0, 0, options};
+                menu.m_options[options++] = item.action;
+            }
+
+            constexpr void place(const Toggle& item, std::uint32_t self, std::uint32_t parent){
+                menu.m_nodes[self] = Node{ItemKind::Toggle, item.label, parent, 0, 0, toggles};
+                menu.m_toggles[toggles++] = ToggleSpec{item.state, item.action};
+            }
+
+            template <typename T>
+            constexpr void place(const Slider<T>& item, std::uint32_t self, std::uint32_t parent){
+                SliderSpec spec {};
+                spec.value = static_cast<double>(item.value);
+                spec.min = static_cast<double>(item.min);
+                spec.max = static_cast<double>(item.max);
+                spec.step = static_cast<double>(item.step);
+                if constexpr (std::is_same<T, int>::value){
+                    spec.numeric = Numeric::Int;
+                    spec.onInt = item.action;
+                }
+                else if constexpr (std::is_same<T, float>::value){
+                    spec.numeric = Numeric::Float;
+                    spec.onFloat = item.action;
+                }
+                else{
+                    spec.numeric = Numeric::Double;
+                    spec.onDouble = item.action;
+                }
+
+                menu.m_nodes[self] = Node{ItemKind::Slider, item.label, parent, 0, 0, sliders};
+                menu.m_sliders[sliders++] = spec;
+            }
+
+            template <typename... Items>
+            constexpr void place(const Page<Items...>& item, std::uint32_t self, std::uint32_t parent){
+                std::uint32_t first = next;
+                next += static_cast<std::uint32_t>(sizeof...(Items));
+                menu.m_nodes[self] = Node{ItemKind::Page, item.label, parent, first,
+                                          static_cast<std::uint32_t>(sizeof...(Items)), 0};
+                placeChildren(item.items, first, self, std::index_sequence_for<Items...>{});
+            }
+
+            template <typename Tuple, std::size_t... I>
+            constexpr void placeChildren(const Tuple& items, [[maybe_unused]] std::uint32_t first, [[maybe_unused]] std::uint32_t self,
+                                         std::index_sequence<I...>){
+                (place(std::get<I>(items), first + static_cast<std::uint32_t>(I), self), ...);
+            }
+        };
+    }
+
+    /**
+    * @brief Flattens a declared tree
+    *
+    * Store the result in a constexpr variable so declaration errors are compile errors.
+    *
+    * @param root declared root page
+    * @return read-only menu
+    */
+    template <typename... Items>
+    constexpr auto build(const Page<Items...>& root){
+        using Root = Page<Items...>;
+        detail::Builder<Menu<Root::nodes, Root::options, Root::toggles, Root::sliders>> builder {};
+        builder.place(root, 0, npos);
+        return builder.menu;
+    }
+
+    /**
+    * @brief Navigator over a Menu made by build().
+    *
+    * Works like MenuNavigator and holds the menu's runtime state: toggle states
+    * and slider values start at their declared values and change as the user
+    * selects and moves items. Neither construction nor navigation allocates.
+    */
+    template <typename M>
+    class Navigator{
+        private:
+            const M& m_menu;
+            std::uint32_t m_currentPage {};
+            int m_currentIndex {};
+            std::array<bool, M::toggleCount> m_states {};
+            std::array<double, M::sliderCount> m_values {};
+
+            /**
+            * @brief Moves a slider the way MenuSlider::onStep does, in the slider's own type
+            */
+            template <typename T>
+            void stepSlider(std::uint32_t node, int steps, void (*action)(T)){
+                const SliderSpec& spec = m_menu.getSlider(node);
+                double& slot = m_values[m_menu.getNode(node).slot];
+                T min = static_cast<T>(spec.min);
+                T max = static_cast<T>(spec.max);
+                T step = static_cast<T>(spec.step);
+                T value = static_cast<T>(slot);
+                T initial = value;
+
+                // compared with the bounds moved by one step, value + step overflows near the type's limits
+                bool canDecrease = min <= std::numeric_limits<T>::max() - step;
+                bool canIncrease = max >= std::numeric_limits<T>::lowest() + step;
+
+                for(; steps < 0 && canDecrease && value >= min + step; ++steps){
+                    value -= step;
+                }
+                for(; steps > 0 && canIncrease && value <= max - step; --steps){
+                    value += step;
+                }
+
+                if(value != initial){
+                    slot = static_cast<double>(value);
+                    if(action){
+                        action(value);
+                    }
+                }
+            }
+
+        public:
+
+            /**
+            * @brief Parametric Navigator constructor
+            *
+            * Starts at the root with every item at its declared state.
+            *
+            * @param menu built menu, must outlive the navigator
+            */
+            constexpr explicit Navigator(const M& menu) : m_menu(menu){
+                for(std::uint32_t node = 0; node < menu.getNodeCount(); ++node){
+                    if(menu.getKind(node) == ItemKind::Toggle){
+                        m_states[menu.getNode(node).slot] = menu.getToggle(node).state;
+                    }
+                    else if(menu.getKind(node) == ItemKind::Slider){
+                        m_values[menu.getNode(node).slot] = menu.getSlider(node).value;
+                    }
+                }
+            }
+
+            /**
+            * @brief Not supported, the navigator keeps a reference to the menu and a temporary would dangle
+            */
+            Navigator(const M&& menu) = delete;
+
+            /**
+            * @brief Returns the menu walked
+            */
+            const M& getMenu() const{
+                return m_menu;
+            }
+
+            /**
+            * @brief Returns node of the current page
+            */
+            std::uint32_t getCurrentPage() const{
+                return m_currentPage;
+            }
+
+            /**
+            * @brief Returns count of items in the current page
+            */
+            int getCurrentCount() const{
+                return static_cast<int>(m_menu.getChildCount(m_currentPage));
+            }
+
+            /**
+            * @brief Returns current index (which item is highlighted)
+            */
+            int getCurrentIndex() const{
+                return m_currentIndex;
+            }
+
+            /**
+            * @brief Returns node of the highlighted item, npos on an empty page
+            */
+            std::uint32_t getCurrentNode() const{
+                if(getCurrentCount() == 0){
+                    return npos;
+                }
+                return m_menu.getChild(m_currentPage, static_cast<std::uint32_t>(m_currentIndex));
+            }
+
+            /**
+            * @brief Returns state of a toggle node
+            */
+            bool getState(std::uint32_t node) const{
+                return m_states[m_menu.getNode(node).slot];
+            }
+
+            /**
+            * @brief Returns value of a slider node
+            */
+            double getValue(std::uint32_t node) const{
+                return m_values[m_menu.getNode(node).slot];
+            }
+
+            /**
+            * @brief Writes the display label of a node, as the matching runtime item shows it
+            *
+            * @param node node to describe
+            * @param buffer destination, not null-terminated
+            * @param size capacity of buffer, the label is cut to fit
+            * @return view of the written part of buffer
+            */
+            std::string_view formatLabel(std::uint32_t node, char* buffer, std::size_t size) const{
+                std::size_t length = 0;
+                auto append = [&](std::string_view text){
+                    std::size_t count = text.size() < size - length ? text.size() : size - length;
+                    for(std::size_t i = 0; i < count; ++i){
+                        buffer[length++] = text[i];
+                    }
+                };
+
+                append(m_menu.getLabel(node));
+
+                if(m_menu.getKind(node) == ItemKind::Toggle){
+                    append(getState(node) ? " [ON]" : " [OFF]");
+                }
+                else if(m_menu.getKind(node) == ItemKind::Slider){
+                    char number[64];
+                    double value = getValue(node);
+                    std::to_chars_result result {};
+                    switch(m_menu.getSlider(node).numeric){
+                        case Numeric::Int: result = std::to_chars(number, number + sizeof(number), static_cast<int>(value)); break;
+                        case Numeric::Float: result = std::to_chars(number, number + sizeof(number), static_cast<float>(value)); break;
+                        case Numeric::Double: result = std::to_chars(number, number + sizeof(number), value); break;
+                    }
+                    append(" < ");
+                    append(std::string_view(number, static_cast<std::size_t>(result.ptr - number)));
+                    append(" >");
+                }
+                return std::string_view(buffer, length);
+            }
+
+            /**
+            * @brief highlights next item in the current page, wrapping around
+            */
+            void next(){
+                int count = getCurrentCount();
+                if(count != 0){
+                    m_currentIndex = m_currentIndex + 1 >= count ? 0 : m_currentIndex + 1;
+                }
+            }
+
+            /**
+            * @brief highlights previous item in the current page, wrapping around
+            */
+            void previous(){
+                int count = getCurrentCount();
+                if(count != 0){
+                    m_currentIndex = m_currentIndex <= 0 ? count - 1 : m_currentIndex - 1;
+                }
+            }
+
+            /**
+            * @brief selects highlighted item
+            *
+            * Enters a page, runs an option's action or flips a toggle. Sliders ignore it.
+            */
+            void select(){
+                std::uint32_t node = getCurrentNode();
+                if(node == npos){
+                    return;
+                }
+
+                switch(m_menu.getKind(node)){
+                    case ItemKind::Page:
+                        m_currentPage = node;
+                        m_currentIndex = 0;
+                        break;
+                    case ItemKind::Option:
+                        if(m_menu.getAction(node)){
+                            m_menu.getAction(node)();
+                        }
+                        break;
+                    case ItemKind::Toggle:{
+                        bool& state = m_states[m_menu.getNode(node).slot];
+                        state = !state;
+                        if(m_menu.getToggle(node).action){
+                            m_menu.getToggle(node).action(state);
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+
+            /**
+            * @brief returns to the parent page
+            */
+            void back(){
+                std::uint32_t parent = m_menu.getParent(m_currentPage);
+                if(parent != npos){
+                    m_currentPage = parent;
+                    m_currentIndex = 0;
+                }
+            }
+
+            /**
+            * @brief moves the highlighted slider by several steps, stopping at its bounds
+            *
+            * @param steps count of steps, negative to decrement
+            */
+            void step(int steps){
+                std::uint32_t node = getCurrentNode();
+                if(node == npos || m_menu.getKind(node) != ItemKind::Slider){
+                    return;
+                }
+
+                const SliderSpec& spec = m_menu.getSlider(node);
+                switch(spec.numeric){
+                    case Numeric::Int: stepSlider<int>(node, steps, spec.onInt); break;
+                    case Numeric::Float: stepSlider<float>(node, steps, spec.onFloat); break;
+                    case Numeric::Double: stepSlider<double>(node, steps, spec.onDouble); break;
+                }
+            }
+
+            /**
+            * @brief moves the highlighted slider one step to the left
+            */
+            void left(){
+                step(-1);
+            }
+
+            /**
+            * @brief moves the highlighted slider one step to the right
+            */
+            void right(){
+                step(1);
+            }
+
+            /**
+            * @brief executes a single navigation command
+            *
+            * @param event command to execute
+            */
+            void dispatch(MenuEvent event){
+                switch(event){
+                    case MenuEvent::Next: next(); break;
+                    case MenuEvent::Previous: previous(); break;
+                    case MenuEvent::Left: left(); break;
+                    case MenuEvent::Right: right(); break;
+                    case MenuEvent::Select: select(); break;
+                    case MenuEvent::Back: back(); break;
+                }
+            }
+    };
+}
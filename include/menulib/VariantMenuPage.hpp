@@ -0,0 +1,279 @@
+#pragma once
+#include "MenuPage.hpp"
+#include "MenuOption.hpp"
+#include "MenuToggle.hpp"
+#include "MenuSlider.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace mr{
+
+    /**
+    * @brief Menu page storing the built-in item kinds inline, dispatched without virtual calls.
+    *
+    * Options, toggles and int/float/double sliders created through emplace() live
+    * inside the page in a closed std::variant, back to back in a deque. When the
+    * navigator is on such a page, select/left/right/step are dispatched with
+    * std::visit to the concrete item type, so the item's handler is a direct call.
+    *
+    * Any other IMenuItem (pages, custom items) is added with addItem() as usual;
+    * it takes the extension slot of the variant and is dispatched virtually.
+    * To the rest of the library the page looks like a plain MenuPage. The class is
+    * final so its items can be read without a MenuPage::ReadGuard: the navigator
+    * reaches them through count(), at() and indexOf() without virtual calls.
+    *
+    * Storage of removed items is reused by the next emplace() or addItem().
+    */
+    class VariantMenuPage final : public MenuPage{
+        public:
+
+            /**
+            * @brief Storage of one item: a built-in kind inline or an extension item by pointer.
+            *
+            * std::monostate marks the storage of a removed inline item.
+            */
+            using Slot = std::variant<std::monostate, MenuOption, MenuToggle,
+                                      MenuSlider<int>, MenuSlider<float>, MenuSlider<double>, IMenuItem*>;
+
+        private:
+
+            /**
+            * @brief Item of the page with the alternative of its slot, read on every dispatch.
+            */
+            struct Entry{
+                IMenuItem* item;
+                Slot* slot;
+                std::uint8_t kind;
+            };
+
+            /**
+            * @brief Alternative of Slot holding extension items.
+            */
+            static constexpr std::uint8_t Extension = std::variant_size<Slot>::value - 1;
+
+            /**
+            * @brief Item storage, never moved so items keep their address.
+            */
+            std::pmr::deque<Slot> m_slots;
+
+            /**
+            * @brief Every item in the page's item order.
+            */
+            std::pmr::vector<Entry> m_order;
+
+            /**
+            * @brief Slots of removed items, holding std::monostate until they are reused.
+            */
+            std::pmr::vector<Slot*> m_free;
+
+            /**
+            * @brief Returns position of an item in m_order, -1 if it is not on the page
+            */
+            int findSlot(const IMenuItem* item) const;
+
+            /**
+            * @brief Returns an empty slot, a freed one if there is any
+            */
+            Slot* takeSlot();
+
+            /**
+            * @brief Runs a handler on the item at an index
+            *
+            * Inline items reach the handler with their concrete type, extension items
+            * as IMenuItem. The kind and the item are read from one entry and a switch
+            * on the kind compiles to a jump table, unlike std::visit, which goes
+            * through a table of function pointers. Kept in the header so callers can
+            * inline it.
+            */
+            template <typename F>
+            void dispatch(int index, F&& handler) const{
+                static_assert(std::variant_size<Slot>::value == 7, "dispatch() must handle every alternative of Slot");
+
+                const Entry& entry = m_order[index];
+                switch(entry.kind){
+                    case 1: handler(static_cast<std::variant_alternative_t<1, Slot>&>(*entry.item)); break;
+                    case 2: handler(static_cast<std::variant_alternative_t<2, Slot>&>(*entry.item)); break;
+                    case 3: handler(static_cast<std::variant_alternative_t<3, Slot>&>(*entry.item)); break;
+                    case 4: handler(static_cast<std::variant_alternative_t<4, Slot>&>(*entry.item)); break;
+                    case 5: handler(static_cast<std::variant_alternative_t<5, Slot>&>(*entry.item)); break;
+                    default: handler(*entry.item); break;
+                }
+            }
+
+            /**
+            * @brief Tells whether a handler got an extension item, which must be called virtually
+            */
+            template <typename T>
+            static constexpr bool isExtension = std::is_same<T, IMenuItem>::value;
+
+        public:
+
+            /**
+            * @brief Parametric Variant Menu Page constructor
+            *
+            * @param title page title
+            * @param parent parent page, nullptr for the root
+            * @param resource memory resource used for the label, the child list and the item storage
+            */
+            VariantMenuPage(std::string_view title, MenuPage* parent = nullptr,
+                            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+            /**
+            * @brief Destroys inline items in place and extension items like MenuPage does
+            */
+            ~VariantMenuPage() override;
+
+            /**
+            * @brief Creates a built-in item inside the page and adds it
+            *
+            * @tparam T MenuOption, MenuToggle or MenuSlider<int/float/double>
+            * @param args constructor arguments of T
+            * @return the item, owned by the page
+            */
+            template <typename T, typename... Args>
+            T& emplace(Args&&... args){
+                static_assert(std::is_base_of<IMenuItem, T>::value, "VariantMenuPage: emplace creates built-in items only");
+
+                Slot* slot = takeSlot();
+                try{
+                    slot->template emplace<T>(std::forward<Args>(args)...);
+                }
+                catch(...){
+                    // a throwing constructor may leave the slot valueless
+                    slot->template emplace<std::monostate>();
+                    m_free.push_back(slot);
+                    throw;
+                }
+
+                T& item = std::get<T>(*slot);
+                m_order.push_back(Entry{&item, slot, static_cast<std::uint8_t>(slot->index())});
+                MenuPage::addItem(&item);
+                return item;
+            }
+
+            /**
+            * @brief Adds an item through the extension slot, dispatched virtually
+            *
+            * @param item item to add, the page takes ownership
+            */
+            void addItem(IMenuItem* item) override;
+
+            /**
+            * @brief Removes an item
+            *
+            * Inline items are destroyed in place, their storage is reused by the next item.
+            */
+            bool removeItem(IMenuItem* item) override;
+
+            /**
+            * @brief Returns count of items, without a guard or a virtual call
+            */
+            int count() const{
+                return static_cast<int>(m_order.size());
+            }
+
+            /**
+            * @brief Returns an item, without a guard or a virtual call
+            *
+            * @param index item index, must be below count()
+            */
+            IMenuItem* at(int index) const{
+                return m_order[index].item;
+            }
+
+            /**
+            * @brief Returns index of an item, -1 if it is not on the page
+            */
+            int indexOf(const IMenuItem* item) const{
+                return findSlot(item);
+            }
+
+            /**
+            * @brief Selects an item, resolving its type without a virtual call
+            */
+            void selectAt(int index, MenuNavigator* navigator){
+                dispatch(index, [navigator](auto& item){
+                    using T = std::decay_t<decltype(item)>;
+                    if constexpr (isExtension<T>){
+                        item.onSelect(navigator);
+                    }
+                    else{
+                        item.T::onSelect(navigator);
+                    }
+                });
+            }
+
+            /**
+            * @brief Moves an item to the left, resolving its type without a virtual call
+            */
+            void leftAt(int index, MenuNavigator* navigator){
+                dispatch(index, [navigator](auto& item){
+                    using T = std::decay_t<decltype(item)>;
+                    if constexpr (isExtension<T>){
+                        item.onLeft(navigator);
+                    }
+                    else{
+                        item.T::onLeft(navigator);
+                    }
+                });
+            }
+
+            /**
+            * @brief Moves an item to the right, resolving its type without a virtual call
+            */
+            void rightAt(int index, MenuNavigator* navigator){
+                dispatch(index, [navigator](auto& item){
+                    using T = std::decay_t<decltype(item)>;
+                    if constexpr (isExtension<T>){
+                        item.onRight(navigator);
+                    }
+                    else{
+                        item.T::onRight(navigator);
+                    }
+                });
+            }
+
+            /**
+            * @brief Moves an item by several steps, resolving its type without a virtual call
+            */
+            void stepAt(int index, MenuNavigator* navigator, int steps){
+                dispatch(index, [navigator, steps](auto& item){
+                    using T = std::decay_t<decltype(item)>;
+                    if constexpr (isExtension<T>){
+                        item.onStep(navigator, steps);
+                    }
+                    else{
+                        item.T::onStep(navigator, steps);
+                    }
+                });
+            }
+
+            /**
+            * @brief Tells whether an item is terminal, resolving its type without a virtual call
+            */
+            bool isEndAt(int index) const{
+                bool end = true;
+                dispatch(index, [&end](auto& item){
+                    using T = std::decay_t<decltype(item)>;
+                    if constexpr (isExtension<T>){
+                        end = item.isEnd();
+                    }
+                    else{
+                        end = item.T::isEnd();
+                    }
+                });
+                return end;
+            }
+
+            /**
+            * @brief Tells whether an item is stored inline rather than through the extension slot
+            */
+            bool isInlineAt(int index) const;
+    };
+}
@@ -1,3 +1,5 @@
+#include <cctype>
+#include <chrono>
 #include <cstddef>
 #include <iostream>
 #include <vector>
@@ -5,9 +7,13 @@
 #include <stdexcept>
 #include <cstdlib>
 
+#include "menulib/MenuArena.hpp"
 #include "menulib/MenuPage.hpp"
 #include "menulib/MenuOption.hpp"
 #include "menulib/MenuNavigator.hpp"
+#include "menulib/MenuEventQueue.hpp"
+#include "menulib/MenuRenderer.hpp"
+#include "menulib/MenuLoop.hpp"
 #include "menulib/MenuToggle.hpp"
 #include "menulib/MenuSlider.hpp"
 
@@ -32,6 +38,8 @@ char getch_(int echo) {
     tcgetattr(STDIN_FILENO, &oldt); // grab old settings
     newt = oldt;
     newt.c_lflag &= ~ICANON;        // disable buffer
+    newt.c_cc[VMIN] = 1;            // wait for a key even if the menu loop is polling
+    newt.c_cc[VTIME] = 0;
 
     if (echo) {
         newt.c_lflag |= ECHO;
@@ -40,21 +48,55 @@ char getch_(int echo) {
     }
 
     tcsetattr(STDIN_FILENO, TCSANOW, &newt); // apply new settings
-    ch = getchar();
+    if (read(STDIN_FILENO, &ch, 1) != 1) {
+        ch = 0;
+    }
     tcsetattr(STDIN_FILENO, TCSANOW, &oldt); // restore old settings
 #endif
 
     return ch;
 }
 
+#ifndef _WIN32
+// keeps the terminal unbuffered and non-blocking while the menu loop runs
+struct PollingTerminal {
+    struct termios old;
+
+    PollingTerminal() {
+        tcgetattr(STDIN_FILENO, &old);
+        struct termios raw = old;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+
+    ~PollingTerminal() {
+        tcsetattr(STDIN_FILENO, TCSANOW, &old);
+    }
+};
+#endif
+
+//returns a pressed key without waiting, 0 if there is none
+char pollKey() {
+#ifdef _WIN32
+    return _kbhit() ? static_cast<char>(_getch()) : 0;
+#else
+    char ch;
+    return read(STDIN_FILENO, &ch, 1) == 1 ? ch : 0;
+#endif
+}
+
 void clear(){
 #ifdef _WIN32
     std::system("cls");
 #else
-    std::system("clear");
+    std::cout << "\x1b[H\x1b[2J" << std::flush;
 #endif
 }
 
+mr::MenuRenderer renderer;
+
 bool isRunning = true;
 bool soundEnabled = true;
 int volumeLevel = 50;
@@ -63,12 +105,14 @@ void videoSettings(){
     std::cout << "\n[!] Video settings changed!\n";
     std::cout << "Press any key to continue...";
     getch_(0);
+    renderer.invalidate();
 }
 
 void startGame(){
     std::cout << "\n[!] Game started!\n";
     std::cout << "Press any key to continue...";
     getch_(0);
+    renderer.invalidate();
 }
 
 void stop(){
@@ -85,71 +129,72 @@ void onVolumeChange(int val){
 
 int main() {
 
-    //forward declaration of menu
-    mr::MenuPage* mainMenu = nullptr;
+    // the arena owns the whole menu tree and releases it in one step
+    mr::MenuArena arena;
 
     try {
-        mainMenu = new mr::MenuPage("Main Menu", nullptr);
+        mr::MenuPage* mainMenu = arena.create<mr::MenuPage>("Main Menu", nullptr);
 
-        mr::MenuPage* settingsMenu = new mr::MenuPage("Settings", mainMenu);
+        mr::MenuPage* settingsMenu = arena.create<mr::MenuPage>("Settings", mainMenu);
 
-        settingsMenu->addItem(new mr::MenuToggle("Sound", soundEnabled, onSoundChange));
+        settingsMenu->addItem(arena.create<mr::MenuToggle>("Sound", soundEnabled, onSoundChange));
 
-        settingsMenu->addItem(new mr::MenuSlider<int>("Volume", volumeLevel, 0, 100, 5, onVolumeChange));
+        settingsMenu->addItem(arena.create<mr::MenuSlider<int>>("Volume", volumeLevel, 0, 100, 5, onVolumeChange));
 
-        settingsMenu->addItem(new mr::MenuOption("Video Settings", videoSettings));
+        settingsMenu->addItem(arena.create<mr::MenuOption>("Video Settings", videoSettings));
 
-        mainMenu->addItem(new mr::MenuOption("Start Game", startGame));
+        mainMenu->addItem(arena.create<mr::MenuOption>("Start Game", startGame));
         mainMenu->addItem(settingsMenu);
-        mainMenu->addItem(new mr::MenuOption("Exit", stop));
+        mainMenu->addItem(arena.create<mr::MenuOption>("Exit", stop));
 
         mr::MenuNavigator nav(mainMenu);
+        nav.setViewportSize(20);
+        mr::MenuEventQueue events(&nav);
+
+        renderer.setFooter({
+            "",
+            "-----------------------------",
+            "[W] Up  [S] Down  [A] Left  [D] Right  [E] Select  [B] Back",
+            "Selection: "
+        });
+
+#ifndef _WIN32
+        PollingTerminal terminal;
+#endif
 
-        while (isRunning) {
-            clear();
-
-            std::cout << "--- " << nav.getCurrentTitle() << " ---\n\n";
-
-            const auto& items = nav.getCurrentItems();
-            int index = nav.getCurrentIndex();
-
-            for (size_t i = 0; i < items.size(); ++i) {
-                if (static_cast<int>(i) == index) {
-                    std::cout << " > " << items[i]->getLabel() << " <\n";
-                } else {
-                    std::cout << "   " << items[i]->getLabel() << "\n";
+        // frames are only drawn when something changed, and then only the changed lines
+        mr::MenuLoop loop(&nav, &events, &renderer, std::cout);
+        loop.setTargetFrameRate(60.0);
+
+        loop.setInputHook([](mr::MenuEventQueue& queue) {
+            for (char input = pollKey(); input != 0; input = pollKey()) {
+                switch (std::tolower(static_cast<unsigned char>(input))) {
+                    case 'w': queue.post(mr::MenuEvent::Previous); break;
+                    case 's': queue.post(mr::MenuEvent::Next); break;
+                    case 'a': queue.post(mr::MenuEvent::Left); break;
+                    case 'd': queue.post(mr::MenuEvent::Right); break;
+                    case 'e': queue.post(mr::MenuEvent::Select); break;
+                    case 'b': queue.post(mr::MenuEvent::Back); break;
+                    default: break;
                 }
             }
+        });
 
-            std::cout << "\n-----------------------------\n";
-            std::cout << "[W] Up  [S] Down  [A] Left  [D] Right  [E] Select  [B] Back\n";
-            std::cout << "Selection: ";
-
-            char input;
-            //std::cin >> input;
-            input = getch_(0);
-            input = std::tolower(input);
-
-            switch (input) {
-                case 'w': nav.previous(); break;
-                case 's': nav.next(); break;
-                case 'a': nav.left(); break;
-                case 'd': nav.right(); break;
-                case 'e': nav(); break;
-                case 'b': nav.back(); break;
-                default: break;
+        loop.setUpdateHook([&loop](std::chrono::nanoseconds) {
+            if (!isRunning) {
+                loop.stop();
             }
-        }
+        });
+
+        loop.run();
     }
     catch (const std::exception& e) {
         clear();
         std::cerr << "Error: " << e.what() << "\n";
-        delete mainMenu;
         return 1;
     }
 
     std::cout << "\nGoodbye!\n";
-    delete mainMenu;
 
     return 0;
 }
@@ -0,0 +1,120 @@
+#include "menulib/ConcurrentMenuPage.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace mr{
+
+    ConcurrentMenuPage::ConcurrentMenuPage(std::string_view title, MenuPage* parent, std::pmr::memory_resource* resource)
+        : MenuPage(title, parent, resource), m_snapshot(new Snapshot{}) {}
+
+    ConcurrentMenuPage::~ConcurrentMenuPage(){
+        const Snapshot* current = m_snapshot.load();
+
+        for(IMenuItem* item : current->items){
+            if(!item->isArenaAllocated()){
+                delete item;
+            }
+        }
+        delete current;
+
+        for(IMenuItem* item : m_retiredItems){
+            delete item;
+        }
+        for(const Snapshot* snapshot : m_retiredSnapshots){
+            delete snapshot;
+        }
+    }
+
+    const void* ConcurrentMenuPage::acquireItems() const{
+        // announce the reader before loading, so a writer seeing no readers
+        // knows every later pin gets the snapshot it just published
+        m_readers.fetch_add(1);
+        return m_snapshot.load();
+    }
+
+    void ConcurrentMenuPage::releaseItems(const void* pin) const{
+        m_readers.fetch_sub(1);
+    }
+
+    int ConcurrentMenuPage::pinnedCount(const void* pin) const{
+        return static_cast<int>(static_cast<const Snapshot*>(pin)->items.size());
+    }
+
+    IMenuItem* ConcurrentMenuPage::pinnedItem(const void* pin, int index) const{
+        return static_cast<const Snapshot*>(pin)->items[index];
+    }
+
+    void ConcurrentMenuPage::publish(const Snapshot* next){
+        m_retiredSnapshots.push_back(m_snapshot.exchange(next));
+    }
+
+    std::size_t ConcurrentMenuPage::reclaimRetired(){
+        if(m_readers.load() != 0){
+            return 0;
+        }
+
+        // everything retired was unpublished before this check, and no reader
+        // that could have loaded it is still pinned
+        std::size_t destroyed = m_retiredItems.size();
+        for(IMenuItem* item : m_retiredItems){
+            delete item;
+        }
+        for(const Snapshot* snapshot : m_retiredSnapshots){
+            delete snapshot;
+        }
+        m_retiredItems.clear();
+        m_retiredSnapshots.clear();
+        return destroyed;
+    }
+
+    void ConcurrentMenuPage::addItem(IMenuItem* item){
+        if(!item){
+            throw std::invalid_argument("ConcurrentMenuPage: Cannot add null item");
+        }
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        Snapshot* next = new Snapshot{*m_snapshot.load()};
+        next->items.push_back(item);
+
+        // ownership is set up before readers can reach the item
+        adopt(item);
+        publish(next);
+        notifyItemAdded(item);
+        reclaimRetired();
+    }
+
+    bool ConcurrentMenuPage::removeItem(IMenuItem* item){
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        const Snapshot* current = m_snapshot.load();
+        auto it = std::find(current->items.begin(), current->items.end(), item);
+        if(it == current->items.end()){
+            return false;
+        }
+
+        Snapshot* next = new Snapshot{};
+        next->items.reserve(current->items.size() - 1);
+        next->items.insert(next->items.end(), current->items.begin(), it);
+        next->items.insert(next->items.end(), it + 1, current->items.end());
+
+        publish(next);
+        notifyItemRemoved(item);
+
+        if(!item->isArenaAllocated()){
+            m_retiredItems.push_back(item);
+        }
+        reclaimRetired();
+        return true;
+    }
+
+    std::size_t ConcurrentMenuPage::reclaim(){
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return reclaimRetired();
+    }
+
+    std::size_t ConcurrentMenuPage::getRetiredCount(){
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return m_retiredItems.size();
+    }
+}
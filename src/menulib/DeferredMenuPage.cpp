@@ -0,0 +1,79 @@
+#include "menulib/DeferredMenuPage.hpp"
+#include <stdexcept>
+
+namespace mr{
+
+    void DeferredMenuPage::Build::run(){
+        std::call_once(done, [this]{
+            std::vector<IMenuItem*> items;
+            try{
+                builder(items);
+            }
+            catch(...){
+                for(IMenuItem* item : items){
+                    if(!item->isArenaAllocated()){
+                        delete item;
+                    }
+                }
+                throw;
+            }
+            pending = std::move(items);
+            prefetched.store(true);
+        });
+    }
+
+    DeferredMenuPage::DeferredMenuPage(std::string_view title, const Builder& builder, MenuPage* parent,
+                                       std::pmr::memory_resource* resource)
+        : MenuPage(title, parent, resource), m_build(std::make_shared<Build>()){
+        m_build->builder = builder;
+        if(!m_build->builder){
+            throw std::invalid_argument("DeferredMenuPage: Builder cannot be empty");
+        }
+    }
+
+    DeferredMenuPage::~DeferredMenuPage(){
+        // waits for a builder running on a worker, and marks the build done so queued tasks skip it
+        std::call_once(m_build->done, []{});
+
+        for(IMenuItem* item : m_build->pending){
+            if(!item->isArenaAllocated()){
+                delete item;
+            }
+        }
+        m_build->pending.clear();
+    }
+
+    void DeferredMenuPage::prefetch(){
+        m_build->run();
+    }
+
+    bool DeferredMenuPage::isPrefetched() const{
+        return m_build->prefetched.load();
+    }
+
+    std::function<void()> DeferredMenuPage::prefetchTask(){
+        return [build = m_build]{
+            build->run();
+        };
+    }
+
+    void DeferredMenuPage::populate(){
+        if(m_populated){
+            return;
+        }
+
+        // waits for a prefetch running on a worker instead of building twice
+        prefetch();
+
+        m_populated = true;
+        std::vector<IMenuItem*> items = std::move(m_build->pending);
+        m_build->pending.clear();
+        for(IMenuItem* item : items){
+            addItem(item);
+        }
+    }
+
+    bool DeferredMenuPage::isPopulated() const{
+        return m_populated;
+    }
+}
@@ -0,0 +1,170 @@
+#include "menulib/FrozenMenu.hpp"
+#include "menulib/ConcurrentMenuPage.hpp"
+#include "menulib/IMenuSlider.hpp"
+#include "menulib/MenuToggle.hpp"
+#include <stdexcept>
+
+namespace mr{
+
+    FrozenMenu::FrozenMenu(MenuPage* root){
+        if(root == nullptr){
+            throw std::invalid_argument("FrozenMenu: Root cannot be nullptr");
+        }
+
+        m_sources.push_back(root);
+
+        // the node vectors double as the breadth-first queue,
+        // so the children of every page end up in one contiguous range
+        for(std::uint32_t node = 0; node < m_sources.size(); ++node){
+            IMenuItem* item = m_sources[node];
+            ItemKind kind = item->getKind();
+
+            m_kinds.push_back(kind);
+            m_parents.push_back(npos);
+            m_firstChild.push_back(0);
+            m_childCount.push_back(0);
+            m_labelOffset.push_back(0);
+            m_labelLength.push_back(0);
+            m_values.push_back(readValue(item));
+            storeLabel(node, item->getLabel());
+
+            if(kind != ItemKind::Page){
+                continue;
+            }
+
+            MenuPage* page = static_cast<MenuPage*>(item);
+            if(page->isLazy()){
+                throw std::invalid_argument("FrozenMenu: Lazy pages cannot be frozen");
+            }
+            // m_sources would keep items other threads may remove and destroy
+            if(dynamic_cast<ConcurrentMenuPage*>(page) != nullptr){
+                throw std::invalid_argument("FrozenMenu: Concurrent pages cannot be frozen");
+            }
+            page->populate();
+            m_pageNodes.emplace(page, node);
+            m_firstChild[node] = static_cast<std::uint32_t>(m_sources.size());
+            MenuPage::ReadGuard children(*page);
+            m_childCount[node] = static_cast<std::uint32_t>(children.count());
+
+            for(int i = 0; i < children.count(); ++i){
+                m_sources.push_back(children.at(i));
+            }
+        }
+
+        for(std::uint32_t node = 0; node < m_sources.size(); ++node){
+            for(std::uint32_t i = 0; i < m_childCount[node]; ++i){
+                m_parents[m_firstChild[node] + i] = node;
+            }
+        }
+    }
+
+    void FrozenMenu::storeLabel(std::uint32_t node, std::string_view label){
+        m_staleBytes += m_labelLength[node];
+        m_labelOffset[node] = static_cast<std::uint32_t>(m_labels.size());
+        m_labelLength[node] = static_cast<std::uint32_t>(label.size());
+        m_labels.append(label.data(), label.size());
+    }
+
+    double FrozenMenu::readValue(const IMenuItem* item){
+        switch(item->getKind()){
+            case ItemKind::Toggle:
+                return static_cast<const MenuToggle*>(item)->getState() ? 1.0 : 0.0;
+            case ItemKind::Slider:
+                return static_cast<const IMenuSlider*>(item)->getNumericValue();
+            default:
+                return 0.0;
+        }
+    }
+
+    void FrozenMenu::compactLabels(){
+        std::string compacted;
+        compacted.reserve(m_labels.size() - m_staleBytes);
+
+        for(std::uint32_t node = 0; node < m_kinds.size(); ++node){
+            std::uint32_t offset = static_cast<std::uint32_t>(compacted.size());
+            compacted.append(m_labels, m_labelOffset[node], m_labelLength[node]);
+            m_labelOffset[node] = offset;
+        }
+
+        m_labels.swap(compacted);
+        m_staleBytes = 0;
+    }
+
+    std::uint32_t FrozenMenu::getNodeCount() const{
+        return static_cast<std::uint32_t>(m_kinds.size());
+    }
+
+    ItemKind FrozenMenu::getKind(std::uint32_t node) const{
+        return m_kinds[node];
+    }
+
+    std::uint32_t FrozenMenu::getParent(std::uint32_t node) const{
+        return m_parents[node];
+    }
+
+    std::uint32_t FrozenMenu::getChildCount(std::uint32_t node) const{
+        return m_childCount[node];
+    }
+
+    std::uint32_t FrozenMenu::getChild(std::uint32_t node, std::uint32_t index) const{
+        return m_firstChild[node] + index;
+    }
+
+    std::string_view FrozenMenu::getLabel(std::uint32_t node) const{
+        return std::string_view(m_labels.data() + m_labelOffset[node], m_labelLength[node]);
+    }
+
+    double FrozenMenu::getValue(std::uint32_t node) const{
+        return m_values[node];
+    }
+
+    IMenuItem* FrozenMenu::getSource(std::uint32_t node) const{
+        return m_sources[node];
+    }
+
+    std::uint32_t FrozenMenu::findPage(const MenuPage* page) const{
+        auto it = m_pageNodes.find(page);
+        return it == m_pageNodes.end() ? npos : it->second;
+    }
+
+    void FrozenMenu::select(std::uint32_t node, MenuNavigator* navigator){
+        m_sources[node]->onSelect(navigator);
+        refresh(node);
+    }
+
+    void FrozenMenu::left(std::uint32_t node, MenuNavigator* navigator){
+        m_sources[node]->onLeft(navigator);
+        refresh(node);
+    }
+
+    void FrozenMenu::right(std::uint32_t node, MenuNavigator* navigator){
+        m_sources[node]->onRight(navigator);
+        refresh(node);
+    }
+
+    void FrozenMenu::step(std::uint32_t node, MenuNavigator* navigator, int steps){
+        m_sources[node]->onStep(navigator, steps);
+        refresh(node);
+    }
+
+    void FrozenMenu::refresh(std::uint32_t node){
+        const IMenuItem* item = m_sources[node];
+        m_values[node] = readValue(item);
+
+        std::string_view label = item->getLabel();
+        if(label != getLabel(node)){
+            storeLabel(node, label);
+
+            if(m_staleBytes > m_labels.size() / 2){
+                compactLabels();
+            }
+        }
+    }
+
+    void FrozenMenu::refresh(){
+        for(std::uint32_t node = 0; node < m_kinds.size(); ++node){
+            refresh(node);
+        }
+    }
+
+}
@@ -0,0 +1,36 @@
+#include "menulib/IMenuItem.hpp"
+#include "menulib/MenuPage.hpp"
+#include <atomic>
+
+namespace mr{
+
+    void IMenuItem::setLabel(std::string_view label){
+        if(!label.empty())
+        {
+            std::string_view previous = m_label;
+            m_label = m_labels->intern(label);
+            m_labels->release(previous);
+
+            notifyLabelChanged();
+        }
+    }
+
+    ItemId IMenuItem::nextId(){
+        // 0 marks "no item" and is never reached, a 64-bit counter does not wrap
+        static std::atomic<ItemId> s_next {1};
+        return s_next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void IMenuItem::notifyLabelChanged(){
+        if(m_owner){
+            m_owner->notifyLabelChanged(this);
+        }
+    }
+
+    void IMenuItem::notifyValueChanged(){
+        if(m_owner){
+            m_owner->notifyValueChanged(this);
+        }
+    }
+
+}
@@ -0,0 +1,116 @@
+#include "menulib/LabelPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace mr{
+
+    namespace{
+
+        /**
+        * @brief Changed whenever a LabelPoolOwner is created or destroyed.
+        */
+        std::atomic<std::uint64_t> ownerGeneration {0};
+
+        /**
+        * @brief Pool of the resource the last item of this thread was constructed with.
+        *
+        * A tree's items share one resource, so the cast in LabelPool::of() runs once
+        * per tree and thread instead of once per item.
+        */
+        struct OwnerCache{
+            std::pmr::memory_resource* resource {};
+            LabelPool* pool {};
+            std::uint64_t generation {};
+        };
+
+        thread_local OwnerCache ownerCache {};
+    }
+
+    LabelPoolOwner::LabelPoolOwner(){
+        ownerGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    LabelPoolOwner::~LabelPoolOwner(){
+        ownerGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    LabelPool::LabelPool(std::pmr::memory_resource* upstream) : m_storage(upstream){}
+
+    LabelPool& LabelPool::shared(){
+        static LabelPool* pool = new LabelPool();
+        return *pool;
+    }
+
+    LabelPool& LabelPool::of(std::pmr::memory_resource* resource){
+        // most items use the default resource, which never owns a pool, the cast is skipped for them
+        if(resource == std::pmr::get_default_resource() || resource == std::pmr::new_delete_resource()){
+            return shared();
+        }
+
+        // a resource at a cached address may be a new one once an owner came or went
+        std::uint64_t generation = ownerGeneration.load(std::memory_order_acquire);
+        if(ownerCache.resource != resource || ownerCache.generation != generation){
+            LabelPoolOwner* owner = dynamic_cast<LabelPoolOwner*>(resource);
+            ownerCache = OwnerCache{resource, owner != nullptr ? &owner->getLabelPool() : &shared(), generation};
+        }
+        return *ownerCache.pool;
+    }
+
+    std::string_view LabelPool::intern(std::string_view label){
+        if(label.empty()){
+            return std::string_view();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_entries.find(label);
+        if(it != m_entries.end()){
+            it->second.refs++;
+            return it->first;
+        }
+
+        char* text = static_cast<char*>(m_storage.allocate(label.size(), 1));
+        std::memcpy(text, label.data(), label.size());
+        std::string_view stored(text, label.size());
+
+        try{
+            m_entries.emplace(stored, Entry{1});
+        }
+        catch(...){
+            m_storage.deallocate(text, label.size(), 1);
+            throw;
+        }
+
+        m_bytes += label.size();
+        return stored;
+    }
+
+    void LabelPool::release(std::string_view label){
+        if(label.empty()){
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_entries.find(label);
+        if(it == m_entries.end() || --it->second.refs != 0){
+            return;
+        }
+
+        std::string_view text = it->first;
+        m_entries.erase(it);
+        m_storage.deallocate(const_cast<char*>(text.data()), text.size(), 1);
+        m_bytes -= text.size();
+    }
+
+    std::size_t LabelPool::getCount() const{
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+    std::size_t LabelPool::getBytes() const{
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bytes;
+    }
+}
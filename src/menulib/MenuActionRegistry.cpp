@@ -0,0 +1,50 @@
+#include "menulib/MenuActionRegistry.hpp"
+#include <stdexcept>
+
+namespace mr{
+
+    namespace{
+        template <typename F>
+        void insert(std::unordered_map<std::string, F>& map, std::string_view name, const F& function){
+            if(name.empty()){
+                throw std::invalid_argument("MenuActionRegistry: Name cannot be empty");
+            }
+            if(!function){
+                throw std::invalid_argument("MenuActionRegistry: Function cannot be null");
+            }
+            if(!map.emplace(std::string(name), function).second){
+                throw std::invalid_argument("MenuActionRegistry: Name is already registered");
+            }
+        }
+
+        template <typename F>
+        const F* find(const std::unordered_map<std::string, F>& map, std::string_view name){
+            auto it = map.find(std::string(name));
+            return it == map.end() ? nullptr : &it->second;
+        }
+    }
+
+    void MenuActionRegistry::addAction(std::string_view name, const std::function<void()>& action){
+        insert(m_actions, name, action);
+    }
+
+    void MenuActionRegistry::addToggle(std::string_view name, const std::function<void(bool)>& callback){
+        insert(m_toggles, name, callback);
+    }
+
+    void MenuActionRegistry::addSlider(std::string_view name, const std::function<void(double)>& callback){
+        insert(m_sliders, name, callback);
+    }
+
+    const std::function<void()>* MenuActionRegistry::findAction(std::string_view name) const{
+        return find(m_actions, name);
+    }
+
+    const std::function<void(bool)>* MenuActionRegistry::findToggle(std::string_view name) const{
+        return find(m_toggles, name);
+    }
+
+    const std::function<void(double)>* MenuActionRegistry::findSlider(std::string_view name) const{
+        return find(m_sliders, name);
+    }
+}
@@ -0,0 +1,45 @@
+#include "menulib/MenuArena.hpp"
+
+namespace mr{
+
+    MenuArena::Resource::Resource(std::size_t initialBlockSize) : std::pmr::monotonic_buffer_resource(initialBlockSize){
+        m_labels.emplace(this);
+    }
+
+    LabelPool& MenuArena::Resource::getLabelPool(){
+        return *m_labels;
+    }
+
+    MenuArena::MenuArena(std::size_t initialBlockSize) : m_resource(initialBlockSize){}
+
+    MenuArena::~MenuArena(){
+        destroyAll();
+    }
+
+    void MenuArena::destroyAll(){
+        for(Node* node = m_head; node != nullptr; node = node->next){
+            node->item->~IMenuItem();
+        }
+        m_head = nullptr;
+        m_tail = nullptr;
+        m_count = 0;
+    }
+
+    std::pmr::memory_resource* MenuArena::getResource(){
+        return &m_resource;
+    }
+
+    std::size_t MenuArena::getCount() const{
+        return m_count;
+    }
+
+    void MenuArena::release(){
+        destroyAll();
+
+        // the pool's storage lives in the blocks, it goes before them
+        m_resource.m_labels.reset();
+        m_resource.release();
+        m_resource.m_labels.emplace(&m_resource);
+    }
+
+}
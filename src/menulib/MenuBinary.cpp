@@ -0,0 +1,448 @@
+#include "menulib/MenuBinary.hpp"
+#include "menulib/IMenuProvider.hpp"
+#include "menulib/IMenuSlider.hpp"
+#include "menulib/MenuOption.hpp"
+#include "menulib/MenuSlider.hpp"
+#include "menulib/MenuToggle.hpp"
+#include "menulib/ProviderMenuPage.hpp"
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mr{
+
+    namespace{
+        constexpr char Magic[8] = {'M', 'E', 'N', 'U', 'L', 'I', 'B', '\0'};
+
+        /**
+        * @brief Written in native order, tells a file from another byte order apart.
+        */
+        constexpr std::uint32_t ByteOrderMark = 0x01020304;
+
+        constexpr std::uint8_t FlagToggleOn = 0x01;
+        constexpr std::uint8_t FlagIntegral = 0x02;
+
+        constexpr std::uint32_t NoSlider = 0xFFFFFFFF;
+
+        struct FileHeader{
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint32_t nodeCount;
+            std::uint32_t sliderCount;
+            std::uint64_t stringBytes;
+        };
+
+        static_assert(sizeof(FileHeader) == 32, "FileHeader layout is part of the file format");
+
+        [[noreturn]] void malformed(const char* what){
+            throw std::runtime_error(std::string("MenuBinary: Malformed file, ") + what);
+        }
+
+        bool isWhole(double value){
+            return value >= INT_MIN && value <= INT_MAX && std::floor(value) == value;
+        }
+    }
+
+    struct MenuBinary::NodeRecord{
+        std::uint8_t kind;
+        std::uint8_t flags;
+        std::uint16_t reserved;
+        std::uint32_t labelOffset;
+        std::uint32_t labelLength;
+        std::uint32_t actionOffset;
+        std::uint32_t actionLength;
+        std::uint32_t firstChild;
+        std::uint32_t childCount;
+        std::uint32_t slider;
+    };
+
+    struct MenuBinary::SliderRecord{
+        double value;
+        double min;
+        double max;
+        double step;
+    };
+
+    /**
+    * @brief Provider building the children of a mapped page.
+    */
+    class MenuBinary::Children : public IMenuProvider{
+        protected:
+            MenuBinary* m_file;
+            std::uint32_t m_node;
+
+        public:
+            Children(MenuBinary* file, std::uint32_t node) : m_file(file), m_node(node) {}
+
+            int getCount() const override{
+                return static_cast<int>(m_file->m_nodes[m_node].childCount);
+            }
+
+            IMenuItem* createItem(int index) override{
+                return m_file->createItem(m_file->m_nodes[m_node].firstChild + static_cast<std::uint32_t>(index));
+            }
+    };
+
+    /**
+    * @brief Page of a mapped file, keeps every child it built.
+    *
+    * Its cache holds all children, so a built child lives as long as the file and
+    * the page is not lazy: settings, indexes and FrozenMenu see its children.
+    */
+    class MenuBinary::Page : private MenuBinary::Children, public ProviderMenuPage{
+        public:
+            Page(MenuBinary* file, std::uint32_t node)
+                : Children(file, node),
+                  ProviderMenuPage(file->getLabel(node), this,
+                                   file->m_nodes[node].childCount > 0 ? file->m_nodes[node].childCount : 1) {}
+
+            bool isLazy() const override{
+                return false;
+            }
+    };
+
+    void MenuBinary::save(const MenuPage& root, const std::string& path, const ActionNames& actions){
+        std::vector<const IMenuItem*> order {&root};
+        std::vector<NodeRecord> nodes;
+        std::vector<SliderRecord> sliders;
+        std::string strings;
+
+        auto store = [&strings](std::string_view text, std::uint32_t& offset, std::uint32_t& length){
+            if(strings.size() + text.size() > UINT32_MAX){
+                throw std::invalid_argument("MenuBinary: Labels exceed 4 GiB");
+            }
+            offset = static_cast<std::uint32_t>(strings.size());
+            length = static_cast<std::uint32_t>(text.size());
+            strings.append(text.data(), text.size());
+        };
+
+        // the order vector doubles as the breadth-first queue, like in FrozenMenu
+        for(std::size_t i = 0; i < order.size(); ++i){
+            const IMenuItem* item = order[i];
+            NodeRecord record {};
+            record.kind = static_cast<std::uint8_t>(item->getKind());
+            record.slider = NoSlider;
+            store(item->getBaseLabel(), record.labelOffset, record.labelLength);
+
+            auto action = actions.find(item);
+            if(action != actions.end()){
+                store(action->second, record.actionOffset, record.actionLength);
+            }
+
+            switch(item->getKind()){
+                case ItemKind::Page: {
+                    MenuPage::ReadGuard children(*static_cast<const MenuPage*>(item));
+                    if(order.size() + children.count() > UINT32_MAX){
+                        throw std::invalid_argument("MenuBinary: Too many items");
+                    }
+                    record.firstChild = static_cast<std::uint32_t>(order.size());
+                    record.childCount = static_cast<std::uint32_t>(children.count());
+                    for(int c = 0; c < children.count(); ++c){
+                        order.push_back(children.at(c));
+                    }
+                    break;
+                }
+                case ItemKind::Option:
+                    break;
+                case ItemKind::Toggle:
+                    if(static_cast<const MenuToggle*>(item)->getState()){
+                        record.flags |= FlagToggleOn;
+                    }
+                    break;
+                case ItemKind::Slider: {
+                    const IMenuSlider* slider = static_cast<const IMenuSlider*>(item);
+                    if(slider->isIntegral()){
+                        record.flags |= FlagIntegral;
+                    }
+                    record.slider = static_cast<std::uint32_t>(sliders.size());
+                    sliders.push_back(SliderRecord{slider->getNumericValue(), slider->getNumericMin(),
+                                                   slider->getNumericMax(), slider->getNumericStep()});
+                    break;
+                }
+                case ItemKind::Custom:
+                    throw std::invalid_argument("MenuBinary: Custom items cannot be saved");
+            }
+            nodes.push_back(record);
+        }
+
+        FileHeader header {};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.byteOrder = ByteOrderMark;
+        header.nodeCount = static_cast<std::uint32_t>(nodes.size());
+        header.sliderCount = static_cast<std::uint32_t>(sliders.size());
+        header.stringBytes = strings.size();
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(NodeRecord));
+        out.write(reinterpret_cast<const char*>(sliders.data()), sliders.size() * sizeof(SliderRecord));
+        out.write(strings.data(), strings.size());
+        out.close();
+
+        if(!out){
+            throw std::runtime_error("MenuBinary: Cannot write " + path);
+        }
+    }
+
+    MenuBinary::MenuBinary(const std::string& path, const MenuActionRegistry* registry) : m_registry(registry){
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE){
+            throw std::runtime_error("MenuBinary: Cannot open " + path);
+        }
+
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(file, &size) || static_cast<std::uint64_t>(size.QuadPart) < sizeof(FileHeader)){
+            CloseHandle(file);
+            malformed("file is too small");
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+
+        // the view keeps the file open on its own
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if(mapping == nullptr){
+            throw std::runtime_error("MenuBinary: Cannot map " + path);
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if(view == nullptr){
+            throw std::runtime_error("MenuBinary: Cannot map " + path);
+        }
+#else
+        int file = ::open(path.c_str(), O_RDONLY);
+        if(file < 0){
+            throw std::runtime_error("MenuBinary: Cannot open " + path);
+        }
+
+        struct stat info;
+        if(::fstat(file, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(FileHeader)){
+            ::close(file);
+            malformed("file is too small");
+        }
+        m_size = static_cast<std::size_t>(info.st_size);
+
+        // the mapping keeps the file open on its own
+        void* view = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if(view == MAP_FAILED){
+            throw std::runtime_error("MenuBinary: Cannot map " + path);
+        }
+#endif
+        m_data = static_cast<const unsigned char*>(view);
+
+        try{
+            validate();
+            checkPage(0);
+            m_root = new Page(this, 0);
+        }
+        catch(...){
+            unmap();
+            throw;
+        }
+    }
+
+    MenuBinary::~MenuBinary(){
+        delete m_root;
+        unmap();
+    }
+
+    void MenuBinary::unmap(){
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+    }
+
+    void MenuBinary::validate(){
+        static_assert(sizeof(NodeRecord) == 32, "NodeRecord layout is part of the file format");
+        static_assert(sizeof(SliderRecord) == 32, "SliderRecord layout is part of the file format");
+
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(m_data);
+
+        if(std::memcmp(header->magic, Magic, sizeof(Magic)) != 0){
+            malformed("not a menu file");
+        }
+        if(header->byteOrder != ByteOrderMark){
+            malformed("written with another byte order");
+        }
+        if(header->version != Version){
+            malformed("unsupported version");
+        }
+
+        std::uint64_t expected = sizeof(FileHeader)
+                               + std::uint64_t(header->nodeCount) * sizeof(NodeRecord)
+                               + std::uint64_t(header->sliderCount) * sizeof(SliderRecord)
+                               + header->stringBytes;
+        if(header->nodeCount == 0 || header->stringBytes > UINT32_MAX || expected != m_size){
+            malformed("size does not match the header");
+        }
+
+        m_nodeCount = header->nodeCount;
+        m_sliderCount = header->sliderCount;
+        m_stringBytes = header->stringBytes;
+        m_nodes = reinterpret_cast<const NodeRecord*>(m_data + sizeof(FileHeader));
+        m_sliders = reinterpret_cast<const SliderRecord*>(m_nodes + m_nodeCount);
+        m_strings = reinterpret_cast<const char*>(m_sliders + m_sliderCount);
+
+        const NodeRecord& root = m_nodes[0];
+        if(root.kind != static_cast<std::uint8_t>(ItemKind::Page)){
+            malformed("root is not a page");
+        }
+        if(std::uint64_t(root.labelOffset) + root.labelLength > m_stringBytes){
+            malformed("string out of range");
+        }
+        if(root.labelLength == 0){
+            malformed("page without a label");
+        }
+    }
+
+    void MenuBinary::checkPage(std::uint32_t node) const{
+        const NodeRecord& page = m_nodes[node];
+        // children always follow their page, so the tree cannot loop
+        if(page.childCount != 0 && (page.firstChild <= node
+                                    || std::uint64_t(page.firstChild) + page.childCount > m_nodeCount)){
+            malformed("children out of range");
+        }
+
+        for(std::uint32_t child = page.firstChild; child < page.firstChild + page.childCount; ++child){
+            const NodeRecord& record = m_nodes[child];
+
+            if(std::uint64_t(record.labelOffset) + record.labelLength > m_stringBytes
+               || std::uint64_t(record.actionOffset) + record.actionLength > m_stringBytes){
+                malformed("string out of range");
+            }
+
+            switch(static_cast<ItemKind>(record.kind)){
+                case ItemKind::Page:
+                    // the item constructors would throw std::invalid_argument on an empty label
+                    if(record.labelLength == 0){
+                        malformed("page without a label");
+                    }
+                    continue;
+                case ItemKind::Option:
+                    if(record.labelLength == 0){
+                        malformed("option without a label");
+                    }
+                    break;
+                case ItemKind::Toggle:
+                    if(record.labelLength == 0){
+                        malformed("toggle without a label");
+                    }
+                    break;
+                case ItemKind::Slider: {
+                    if(record.slider >= m_sliderCount || record.labelLength == 0){
+                        malformed("slider without a range");
+                    }
+                    const SliderRecord& slider = m_sliders[record.slider];
+                    if(!(slider.min < slider.max) || !(slider.value >= slider.min && slider.value <= slider.max)
+                       || !(slider.step > 0) || !std::isfinite(slider.min) || !std::isfinite(slider.max)){
+                        malformed("invalid slider range");
+                    }
+                    if((record.flags & FlagIntegral) && !(isWhole(slider.value) && isWhole(slider.min)
+                                                         && isWhole(slider.max) && isWhole(slider.step))){
+                        malformed("invalid integral slider range");
+                    }
+                    break;
+                }
+                default:
+                    malformed("unknown item kind");
+            }
+
+            if(record.childCount != 0){
+                malformed("children on a non-page item");
+            }
+        }
+    }
+
+    IMenuItem* MenuBinary::createItem(std::uint32_t node){
+        const NodeRecord& record = m_nodes[node];
+        std::string_view label = stringAt(record.labelOffset, record.labelLength);
+        std::string_view action = stringAt(record.actionOffset, record.actionLength);
+        bool named = m_registry != nullptr && !action.empty();
+
+        switch(static_cast<ItemKind>(record.kind)){
+            case ItemKind::Page:
+                checkPage(node);
+                return new Page(this, node);
+
+            case ItemKind::Option: {
+                const std::function<void()>* function = named ? m_registry->findAction(action) : nullptr;
+                // the registry outlives the items, a pointer fits the inline storage on any platform
+                return function ? new MenuOption(label, [function](){ (*function)(); }) : new MenuOption(label);
+            }
+
+            case ItemKind::Toggle: {
+                bool state = (record.flags & FlagToggleOn) != 0;
+                const std::function<void(bool)>* function = named ? m_registry->findToggle(action) : nullptr;
+                return function ? new MenuToggle(label, state, [function](bool on){ (*function)(on); })
+                                : new MenuToggle(label, state);
+            }
+
+            default: {
+                const SliderRecord& slider = m_sliders[record.slider];
+                const std::function<void(double)>* function = named ? m_registry->findSlider(action) : nullptr;
+
+                if(record.flags & FlagIntegral){
+                    MenuCallback<void(int)> callback = [](int){};
+                    if(function){
+                        callback = [function](int value){ (*function)(value); };
+                    }
+                    return new MenuSlider<int>(label, static_cast<int>(slider.value), static_cast<int>(slider.min),
+                                               static_cast<int>(slider.max), static_cast<int>(slider.step), std::move(callback));
+                }
+
+                MenuCallback<void(double)> callback = [](double){};
+                if(function){
+                    callback = [function](double value){ (*function)(value); };
+                }
+                return new MenuSlider<double>(label, slider.value, slider.min, slider.max, slider.step, std::move(callback));
+            }
+        }
+    }
+
+    std::string_view MenuBinary::stringAt(std::uint32_t offset, std::uint32_t length) const{
+        return std::string_view(m_strings + offset, length);
+    }
+
+    MenuPage* MenuBinary::getRoot() const{
+        return m_root;
+    }
+
+    std::uint32_t MenuBinary::getNodeCount() const{
+        return m_nodeCount;
+    }
+
+    ItemKind MenuBinary::getKind(std::uint32_t node) const{
+        if(node >= m_nodeCount){
+            throw std::out_of_range("MenuBinary: Node index out of range");
+        }
+        return static_cast<ItemKind>(m_nodes[node].kind);
+    }
+
+    std::string_view MenuBinary::getLabel(std::uint32_t node) const{
+        if(node >= m_nodeCount){
+            throw std::out_of_range("MenuBinary: Node index out of range");
+        }
+        return stringAt(m_nodes[node].labelOffset, m_nodes[node].labelLength);
+    }
+}
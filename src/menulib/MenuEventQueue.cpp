@@ -0,0 +1,96 @@
+#include "menulib/MenuEventQueue.hpp"
+#include <stdexcept>
+
+namespace mr{
+
+    MenuEventQueue::MenuEventQueue(MenuNavigator* navigator) : m_navigator(navigator){
+        if(navigator == nullptr){
+            throw std::invalid_argument("MenuEventQueue: Navigator cannot be nullptr");
+        }
+    }
+
+    void MenuEventQueue::post(MenuEvent event){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(event);
+        if(m_recorder){
+            m_recorder->record(event);
+        }
+    }
+
+    void MenuEventQueue::setRecorder(MenuRecorder* recorder){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_recorder = recorder;
+    }
+
+    bool MenuEventQueue::process(){
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_batch.swap(m_pending);
+        }
+
+        m_lastBatchSize = m_batch.size();
+        m_lastDispatchCount = 0;
+
+        int moves = 0;
+        int steps = 0;
+
+        // a pending run is applied before any event of another kind
+        auto flush = [&](){
+            if(moves != 0){
+                m_navigator->move(moves);
+                m_lastDispatchCount++;
+                moves = 0;
+            }
+            if(steps != 0){
+                m_navigator->step(steps);
+                m_lastDispatchCount++;
+                steps = 0;
+            }
+        };
+
+        for(MenuEvent event : m_batch){
+            switch(event){
+                case MenuEvent::Next:
+                case MenuEvent::Previous:
+                    if(steps != 0){
+                        flush();
+                    }
+                    moves += (event == MenuEvent::Next) ? 1 : -1;
+                    break;
+                case MenuEvent::Left:
+                case MenuEvent::Right:
+                    // steps stop at the slider bounds, so a direction change
+                    // cannot be netted out without changing the result
+                    if(moves != 0 || (steps > 0 && event == MenuEvent::Left) || (steps < 0 && event == MenuEvent::Right)){
+                        flush();
+                    }
+                    steps += (event == MenuEvent::Right) ? 1 : -1;
+                    break;
+                case MenuEvent::Select:
+                case MenuEvent::Back:
+                    flush();
+                    m_navigator->dispatch(event);
+                    m_lastDispatchCount++;
+                    break;
+            }
+        }
+        flush();
+
+        m_batch.clear();
+        return m_lastBatchSize != 0;
+    }
+
+    std::size_t MenuEventQueue::getPendingCount(){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+
+    std::size_t MenuEventQueue::getLastBatchSize() const{
+        return m_lastBatchSize;
+    }
+
+    std::size_t MenuEventQueue::getLastDispatchCount() const{
+        return m_lastDispatchCount;
+    }
+
+}
@@ -0,0 +1,74 @@
+#include "menulib/MenuIndex.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace mr{
+
+    MenuIndex::MenuIndex(MenuPage* root) : m_root(root), m_paths(root){
+        if(root == nullptr){
+            throw std::invalid_argument("MenuIndex: Root cannot be nullptr");
+        }
+
+        // taken before m_mutex like in the callbacks, and no change may slip in before attaching
+        MenuPage::ObserverLock observers;
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_paths.build(*this);
+        root->addObserver(this);
+    }
+
+    MenuIndex::~MenuIndex(){
+        m_root->removeObserver(this);
+    }
+
+    MenuIndex::Entry MenuIndex::entryOf(const MenuPaths::Node* node){
+        return Entry{node->item, node->page, node->index};
+    }
+
+    void MenuIndex::pathAdded(const MenuPaths::Node& node, bool){
+        m_byPath.emplace(node.path, &node);
+        m_byId[node.item->getId()] = &node;
+    }
+
+    void MenuIndex::pathRemoved(const MenuPaths::Node& node, bool){
+        m_byPath.erase(node.path);
+        m_byId.erase(node.item->getId());
+    }
+
+    MenuIndex::Entry MenuIndex::find(ItemId id) const{
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_byId.find(id);
+        return it != m_byId.end() ? entryOf(it->second) : Entry{};
+    }
+
+    MenuIndex::Entry MenuIndex::find(std::string_view path) const{
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_byPath.find(path);
+        return it != m_byPath.end() ? entryOf(it->second) : Entry{};
+    }
+
+    std::string MenuIndex::getPath(const IMenuItem* item) const{
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const MenuPaths::Node* node = m_paths.find(item);
+        return node != nullptr ? node->path : std::string();
+    }
+
+    std::size_t MenuIndex::size() const{
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_paths.size();
+    }
+
+    void MenuIndex::onItemAdded(MenuPage* page, IMenuItem* item){
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_paths.add(page, item, *this);
+    }
+
+    void MenuIndex::onItemRemoved(MenuPage* page, IMenuItem* item){
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_paths.remove(page, item, *this);
+    }
+
+    void MenuIndex::onLabelChanged(IMenuItem* item){
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_paths.relabel(item, *this);
+    }
+}
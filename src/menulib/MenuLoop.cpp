@@ -0,0 +1,174 @@
+#include "menulib/MenuLoop.hpp"
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace mr{
+
+    MenuLoop::MenuLoop(MenuNavigator* navigator, MenuEventQueue* events, MenuRenderer* renderer, std::ostream& out)
+        : m_navigator(navigator), m_events(events), m_renderer(renderer), m_out(out){
+        if(navigator == nullptr || events == nullptr || renderer == nullptr){
+            throw std::invalid_argument("MenuLoop: Navigator, event queue and renderer cannot be nullptr");
+        }
+
+        setTargetFrameRate(60.0);
+
+        m_root = navigator->getRoot();
+        if(m_root != nullptr){
+            m_root->addObserver(this);
+        }
+    }
+
+    MenuLoop::~MenuLoop(){
+        if(m_root != nullptr){
+            m_root->removeObserver(this);
+        }
+    }
+
+    void MenuLoop::setTargetFrameRate(double framesPerSecond){
+        if(!(framesPerSecond > 0.0)){
+            throw std::invalid_argument("MenuLoop: Frame rate must be positive");
+        }
+        m_period = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / framesPerSecond));
+        m_budget = m_period;
+    }
+
+    void MenuLoop::setFrameBudget(std::chrono::nanoseconds budget){
+        m_budget = budget;
+    }
+
+    void MenuLoop::setRefreshInterval(std::chrono::nanoseconds interval){
+        m_refreshInterval = interval;
+    }
+
+    void MenuLoop::setInputHook(InputHook hook){
+        m_input = std::move(hook);
+    }
+
+    void MenuLoop::setUpdateHook(UpdateHook hook){
+        m_update = std::move(hook);
+    }
+
+    void MenuLoop::setFrameHook(FrameHook hook){
+        m_frameHook = std::move(hook);
+    }
+
+    bool MenuLoop::tick(){
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point start = Clock::now();
+        std::chrono::nanoseconds elapsed = m_lastTick == Clock::time_point{} ? std::chrono::nanoseconds{} : start - m_lastTick;
+        m_lastTick = start;
+
+        if(m_input){
+            m_input(*m_events);
+        }
+        Clock::time_point polled = Clock::now();
+
+        bool changed = m_events->process();
+        if(m_update){
+            m_update(elapsed);
+        }
+        Clock::time_point updated = Clock::now();
+
+        // cleared before drawing, so a change made while drawing is drawn next frame
+        changed = m_dirty.exchange(false) || changed;
+        if(!changed && m_refreshInterval.count() > 0 && updated - m_lastRender >= m_refreshInterval){
+            changed = true;
+        }
+        if(changed){
+            m_renderer->render(*m_navigator, m_out);
+            m_lastRender = updated;
+        }
+        Clock::time_point rendered = Clock::now();
+
+        FrameTimings& frame = m_lastFrame;
+        frame.frame = m_stats.frames;
+        frame.input = polled - start;
+        frame.update = updated - polled;
+        frame.render = changed ? rendered - updated : std::chrono::nanoseconds{};
+        frame.total = rendered - start;
+        frame.rendered = changed;
+        frame.overBudget = frame.total > m_budget;
+
+        m_stats.frames++;
+        m_stats.renderedFrames += frame.rendered ? 1 : 0;
+        m_stats.overBudgetFrames += frame.overBudget ? 1 : 0;
+        m_stats.inputTotal += frame.input;
+        m_stats.updateTotal += frame.update;
+        m_stats.renderTotal += frame.render;
+        if(frame.total > m_stats.worst.total){
+            m_stats.worst = frame;
+        }
+
+        if(m_frameHook){
+            m_frameHook(frame);
+        }
+        return changed;
+    }
+
+    void MenuLoop::run(){
+        using Clock = std::chrono::steady_clock;
+
+        m_running = true;
+        Clock::time_point next = Clock::now();
+
+        // a stop() made before run() started is kept in the flag and ends it at once
+        while(!m_stopRequested.load()){
+            tick();
+
+            next += m_period;
+            Clock::time_point now = Clock::now();
+            if(next > now){
+                std::this_thread::sleep_until(next);
+            }
+            else{
+                // late frames are not made up for
+                next = now;
+            }
+        }
+
+        m_stopRequested = false;
+        m_running = false;
+    }
+
+    void MenuLoop::stop(){
+        m_stopRequested = true;
+    }
+
+    bool MenuLoop::isRunning() const{
+        return m_running;
+    }
+
+    void MenuLoop::requestRedraw(){
+        m_dirty = true;
+    }
+
+    const FrameTimings& MenuLoop::getLastFrame() const{
+        return m_lastFrame;
+    }
+
+    const FrameStats& MenuLoop::getStats() const{
+        return m_stats;
+    }
+
+    void MenuLoop::resetStats(){
+        m_stats = FrameStats{};
+    }
+
+    void MenuLoop::onItemAdded(MenuPage* page, IMenuItem* item){
+        m_dirty = true;
+    }
+
+    void MenuLoop::onItemRemoved(MenuPage* page, IMenuItem* item){
+        m_dirty = true;
+    }
+
+    void MenuLoop::onLabelChanged(IMenuItem* item){
+        m_dirty = true;
+    }
+
+    void MenuLoop::onValueChanged(IMenuItem* item){
+        m_dirty = true;
+    }
+}
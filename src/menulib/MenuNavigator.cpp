@@ -1,21 +1,80 @@
 #include "menulib/MenuNavigator.hpp"
+#include "menulib/VariantMenuPage.hpp"
+#include "menulib/MenuStats.hpp"
+#include "menulib/MenuIndex.hpp"
+#include <algorithm>
 
 namespace mr{
     MenuNavigator::MenuNavigator(MenuPage* root) : m_root(root), m_currentMenu(root), m_currentIndex(0){
         if(root == nullptr){
             throw std::invalid_argument("MenuNavigator: Root cannot be nullptr");
         }
+        m_variantMenu = dynamic_cast<VariantMenuPage*>(root);
     }
 
-    const std::vector<IMenuItem*>& MenuNavigator::getCurrentItems() const{
+    MenuNavigator::MenuNavigator(FrozenMenu* frozen) : m_currentIndex(0), m_frozen(frozen), m_frozenPage(0){
+        if(frozen == nullptr){
+            throw std::invalid_argument("MenuNavigator: Frozen menu cannot be nullptr");
+        }
+        m_root = static_cast<MenuPage*>(frozen->getSource(0));
+        m_currentMenu = m_root;
+    }
+
+    const std::pmr::vector<IMenuItem*>& MenuNavigator::getCurrentItems() const{
+        if(m_frozen){
+            throw std::logic_error("MenuNavigator: getCurrentItems is not available in frozen mode");
+        }
        return m_currentMenu->getItems();
     }
 
+    int MenuNavigator::getCurrentCount() const{
+        return syncCount();
+    }
+
+    std::string_view MenuNavigator::getCurrentLabel(int index) const{
+        if(m_frozen){
+            return m_frozen->getLabel(m_frozen->getChild(m_frozenPage, index));
+        }
+        return m_currentMenu->getItem(index)->getLabel();
+    }
+
+    MenuPage* MenuNavigator::getCurrentMenu() const{
+        return m_currentMenu;
+    }
+
+    MenuPage* MenuNavigator::getRoot() const{
+        return m_root;
+    }
+
+    IMenuItem* MenuNavigator::getCurrentItem() const{
+        if(m_frozen){
+            if(m_frozen->getChildCount(m_frozenPage) == 0){
+                return nullptr;
+            }
+            return m_frozen->getSource(m_frozen->getChild(m_frozenPage, m_currentIndex));
+        }
+
+        MenuPage::ReadGuard items(*m_currentMenu);
+
+        if(syncCursor(items) == 0){
+            return nullptr;
+        }
+        return items.at(m_currentIndex);
+    }
+
+    bool MenuNavigator::isFrozen() const{
+        return m_frozen != nullptr;
+    }
+
     int MenuNavigator::getCurrentIndex() const{
+        syncCount();
         return m_currentIndex;
     }
 
-    const std::string& MenuNavigator::getCurrentTitle() const{
+    std::string_view MenuNavigator::getCurrentTitle() const{
+        if(m_frozen){
+            return m_frozen->getLabel(m_frozenPage);
+        }
         return m_currentMenu->getLabel();
     }
 
@@ -23,51 +82,408 @@ namespace mr{
         if(currentMenu == nullptr){
             throw std::invalid_argument("MenuNavigator: currentMenu cannot be nullptr");
         }
-        m_currentMenu = currentMenu;
+
+        Position from = currentPosition();
+        bool child = currentMenu->getParent() == m_currentMenu && currentMenu != m_currentMenu;
+
+        openPage(currentMenu);
+
+        // a page reached any other way than from its parent starts a new trail
+        if(child){
+            m_back.push(from);
+        }
+        else{
+            m_back.clear();
+        }
+        m_forward.clear();
+    }
+
+    void MenuNavigator::openPage(MenuPage* page){
+        if(m_frozen){
+            std::uint32_t node = m_frozen->findPage(page);
+            if(node == FrozenMenu::npos){
+                throw std::invalid_argument("MenuNavigator: currentMenu is not part of the frozen menu");
+            }
+            m_frozenPage = node;
+        }
+        else{
+            page->populate();
+            // resolved once per page so moving over its items needs no cast
+            m_variantMenu = dynamic_cast<VariantMenuPage*>(page);
+        }
+        m_currentMenu = page;
 
         m_currentIndex = 0;
+        m_viewportOffset = 0;
+
+        if(m_frozen){
+            m_currentItem = nullptr;
+            return;
+        }
+
+        MenuPage::ReadGuard items(*m_currentMenu);
+        trackCursor(items);
     }
 
-    void MenuNavigator::next(){
-        int count = m_currentMenu->getCount();
+    MenuNavigator::Position MenuNavigator::currentPosition() const{
+        syncCount();
+        return Position{m_currentMenu, m_frozenPage, m_currentIndex, m_currentItem};
+    }
 
-        if (count == 0){
+    void MenuNavigator::restore(const Position& position){
+        if(m_frozen){
+            m_frozenPage = position.node;
+            m_currentMenu = position.page;
+            m_currentIndex = position.index > 0 ? position.index : 0;
+            m_currentItem = nullptr;
+            m_viewportOffset = 0;
+
+            if(position.index < 0){
+                for(std::uint32_t i = 0; i < m_frozen->getChildCount(position.node); ++i){
+                    if(m_frozen->getSource(m_frozen->getChild(position.node, i)) == position.item){
+                        m_currentIndex = static_cast<int>(i);
+                        break;
+                    }
+                }
+            }
+            followCursor();
             return;
         }
 
-        m_currentIndex++;
+        openPage(position.page);
+
+        // the page may have changed since, the item is looked up again if it moved
+        MenuPage::ReadGuard items(*m_currentMenu);
+        m_currentIndex = position.index > 0 ? position.index : 0;
+        m_currentItem = position.item;
+        syncCursor(items);
+        trackCursor(items);
+    }
 
-        // wrap around to the start if we exceed list size
-        if(m_currentIndex >= count)
-        {
-            m_currentIndex = 0;
+    bool MenuNavigator::ascend(){
+        Position left = currentPosition();
+        Position parent;
+
+        if(m_frozen){
+            parent.node = m_frozen->getParent(m_frozenPage);
+            if(parent.node == FrozenMenu::npos){
+                return false;
+            }
+            parent.page = static_cast<MenuPage*>(m_frozen->getSource(parent.node));
+        }
+        else{
+            parent.page = m_currentMenu->getParent();
+            if(parent.page == nullptr){
+                return false;
+            }
+        }
+
+        if(!m_back.empty() && m_back.top().page == parent.page){
+            parent = m_back.top();
+            m_back.pop();
+        }
+        else{
+            // deeper than the history reaches, or not entered from the parent
+            m_back.clear();
+            parent.index = -1;
+            parent.item = left.page;
         }
+
+        restore(parent);
+        m_forward.push(left);
+        return true;
     }
 
-    void MenuNavigator::previous(){
-        int count = m_currentMenu->getCount();
+    bool MenuNavigator::forward(){
+        if(m_forward.empty()){
+            return false;
+        }
+        Position target = m_forward.top();
+
+        // the submenu may have been taken off the page meanwhile, its pointer is only compared
+        bool child;
+        if(m_frozen){
+            child = m_frozen->getParent(target.node) == m_frozenPage;
+        }
+        else{
+            MenuPage::ReadGuard items(*m_currentMenu);
+            int found = items.indexOf(target.page);
+            child = found >= 0 && items.at(found)->getKind() == ItemKind::Page;
+        }
+
+        if(!child){
+            m_forward.clear();
+            return false;
+        }
+
+        m_forward.pop();
+        m_back.push(currentPosition());
+        restore(target);
+        return true;
+    }
+
+    void MenuNavigator::root(){
+        while(ascend()){}
+    }
+
+    bool MenuNavigator::canGoForward() const{
+        return !m_forward.empty();
+    }
+
+    int MenuNavigator::getDepth() const{
+        int depth = 0;
+        if(m_frozen){
+            for(std::uint32_t node = m_frozen->getParent(m_frozenPage); node != FrozenMenu::npos; node = m_frozen->getParent(node)){
+                depth++;
+            }
+            return depth;
+        }
+        for(const MenuPage* page = m_currentMenu->getParent(); page != nullptr; page = page->getParent()){
+            depth++;
+        }
+        return depth;
+    }
+
+    void MenuNavigator::getBreadcrumbs(std::vector<MenuPage*>& pages) const{
+        pages.clear();
+        if(m_frozen){
+            for(std::uint32_t node = m_frozenPage; node != FrozenMenu::npos; node = m_frozen->getParent(node)){
+                pages.push_back(static_cast<MenuPage*>(m_frozen->getSource(node)));
+            }
+        }
+        else{
+            for(MenuPage* page = m_currentMenu; page != nullptr; page = page->getParent()){
+                pages.push_back(page);
+            }
+        }
+        std::reverse(pages.begin(), pages.end());
+    }
+
+    void MenuNavigator::History::push(const Position& position){
+        if(m_count == HistoryDepth){
+            // the oldest step makes room
+            m_first = (m_first + 1) % HistoryDepth;
+            m_count--;
+        }
+        m_entries[(m_first + m_count) % HistoryDepth] = position;
+        m_count++;
+    }
+
+    void MenuNavigator::History::pop(){
+        m_count--;
+    }
+
+    const MenuNavigator::Position& MenuNavigator::History::top() const{
+        return m_entries[(m_first + m_count - 1) % HistoryDepth];
+    }
+
+    void MenuNavigator::History::clear(){
+        m_first = 0;
+        m_count = 0;
+    }
+
+    bool MenuNavigator::History::empty() const{
+        return m_count == 0;
+    }
+
+    bool MenuNavigator::openItem(const IMenuItem* item, int hint){
+        if(item == nullptr || item->getOwner() == nullptr){
+            return false;
+        }
+
+        MenuPage* page = item->getOwner();
+        int index = -1;
+
+        if(m_frozen){
+            std::uint32_t node = m_frozen->findPage(page);
+            if(node == FrozenMenu::npos){
+                return false;
+            }
+            std::uint32_t count = m_frozen->getChildCount(node);
+            if(hint >= 0 && static_cast<std::uint32_t>(hint) < count && m_frozen->getSource(m_frozen->getChild(node, hint)) == item){
+                index = hint;
+            }
+            for(std::uint32_t i = 0; index < 0 && i < count; ++i){
+                if(m_frozen->getSource(m_frozen->getChild(node, i)) == item){
+                    index = static_cast<int>(i);
+                }
+            }
+        }
+        else{
+            // only pages below the navigated root can be opened
+            const MenuPage* above = page;
+            while(above != nullptr && above != m_root){
+                above = above->getParent();
+            }
+            if(above == nullptr){
+                return false;
+            }
+
+            MenuPage::ReadGuard items(*page);
+            index = hint >= 0 && hint < items.count() && items.at(hint) == item ? hint : items.indexOf(item);
+        }
+
+        if(index < 0){
+            return false;
+        }
+
+        setCurrentMenu(page);
+
+        if(m_frozen){
+            m_currentIndex = index;
+            followCursor();
+            return true;
+        }
+
+        MenuPage::ReadGuard items(*m_currentMenu);
+        m_currentIndex = index;
+        m_currentItem = item;
+        syncCursor(items);
+        trackCursor(items);
+        return true;
+    }
+
+    bool MenuNavigator::jumpTo(const IMenuItem* item){
+        return openItem(item, -1);
+    }
+
+    bool MenuNavigator::jumpTo(const MenuIndex& index, ItemId id){
+        MenuIndex::Entry entry = index.find(id);
+        return openItem(entry.item, entry.index);
+    }
+
+    bool MenuNavigator::jumpTo(const MenuIndex& index, std::string_view path){
+        MenuIndex::Entry entry = index.find(path);
+        return openItem(entry.item, entry.index);
+    }
 
-        if (count == 0){
+    template <typename Items>
+    int MenuNavigator::syncItems(const Items& items, bool lazy) const{
+        int count = items.count();
+
+        // children of lazy pages are only known by their index
+        if(lazy){
+            if(m_currentIndex >= count){
+                m_currentIndex = count > 0 ? count - 1 : 0;
+                followCursor();
+            }
+            return count;
+        }
+
+        if(m_currentIndex < count && items.at(m_currentIndex) == m_currentItem){
+            return count;
+        }
+
+        // the page changed since the last call, follow the highlighted item
+        int found = m_currentItem ? items.indexOf(m_currentItem) : -1;
+        if(found >= 0){
+            m_currentIndex = found;
+            followCursor();
+            return count;
+        }
+
+        // the highlighted item is gone, keep the highlight at the same row
+        if(m_currentIndex >= count){
+            m_currentIndex = count > 0 ? count - 1 : 0;
+        }
+        m_currentItem = count > 0 ? items.at(m_currentIndex) : nullptr;
+        followCursor();
+        return count;
+    }
+
+    template <typename Items>
+    void MenuNavigator::trackItems(const Items& items, bool lazy){
+        if(!lazy){
+            m_currentItem = m_currentIndex < items.count() ? items.at(m_currentIndex) : nullptr;
+        }
+        followCursor();
+    }
+
+    template <typename F>
+    void MenuNavigator::moveCursor(F target){
+        // the flat arrays know the count, the source page is not pinned
+        if(m_frozen){
+            int count = static_cast<int>(m_frozen->getChildCount(m_frozenPage));
+            if(count != 0){
+                m_currentIndex = target(m_currentIndex, count);
+                followCursor();
+            }
+            return;
+        }
+
+        // a VariantMenuPage is final and pins nothing, its items are read without a guard
+        if(m_variantMenu){
+            int count = syncItems(*m_variantMenu, false);
+            if(count != 0){
+                m_currentIndex = target(m_currentIndex, count);
+                trackItems(*m_variantMenu, false);
+            }
+            return;
+        }
+
+        MenuPage::ReadGuard items(*m_currentMenu);
+        int count = syncCursor(items);
+
+        if(count == 0){
             return;
         }
 
-        m_currentIndex--;
+        m_currentIndex = target(m_currentIndex, count);
+        trackCursor(items);
+    }
 
-        // wrap around to the end if we exceed list size
-        if(m_currentIndex < 0)
-        {
-            m_currentIndex = count-1;
+    int MenuNavigator::syncCount() const{
+        if(m_frozen){
+            return static_cast<int>(m_frozen->getChildCount(m_frozenPage));
+        }
+        if(m_variantMenu){
+            return syncItems(*m_variantMenu, false);
         }
+
+        MenuPage::ReadGuard items(*m_currentMenu);
+        return syncCursor(items);
+    }
+
+    void MenuNavigator::next(){
+        moveCursor([](int index, int count){
+            // wrap around to the start if we exceed list size
+            return index + 1 >= count ? 0 : index + 1;
+        });
+    }
+
+    void MenuNavigator::previous(){
+        moveCursor([](int index, int count){
+            // wrap around to the end if we exceed list size
+            return index - 1 < 0 ? count - 1 : index - 1;
+        });
     }
 
     void MenuNavigator::select() {
-            if (!m_currentMenu){
+            if (m_frozen){
+                if (m_frozen->getChildCount(m_frozenPage) == 0){
+                    return;
+                }
+
+                std::uint32_t node = m_frozen->getChild(m_frozenPage, m_currentIndex);
+                MENULIB_INSTRUMENT(m_frozen->getSource(node), Select);
+
+                // entering a page is resolved on the flat arrays alone
+                if (m_frozen->getKind(node) == ItemKind::Page){
+                    m_back.push(Position{m_currentMenu, m_frozenPage, m_currentIndex, nullptr});
+                    m_forward.clear();
+                    m_frozenPage = node;
+                    m_currentMenu = static_cast<MenuPage*>(m_frozen->getSource(node));
+                    m_currentIndex = 0;
+                    m_viewportOffset = 0;
+                    m_currentItem = nullptr;
+                    return;
+                }
+
+                m_frozen->select(node, this);
                 return;
             }
 
-            const std::vector<IMenuItem*>& items = m_currentMenu->getItems();
-
-            if (items.empty()) {
+            if (!m_currentMenu){
                 return;
             }
 
@@ -75,13 +491,156 @@ namespace mr{
             // If it's a Page it will use the navigator to enter the submenu
             // All other items will ignore the navigator and/or execute their function
 
-            items[m_currentIndex]->onSelect(this);
+            if (m_variantMenu){
+                if (syncItems(*m_variantMenu, false) == 0) {
+                    return;
+                }
+                MENULIB_INSTRUMENT(m_variantMenu->at(m_currentIndex), Select);
+                m_variantMenu->selectAt(m_currentIndex, this);
+                return;
+            }
+
+            // the pin keeps the item alive while it runs, even if it is removed meanwhile
+            MenuPage::ReadGuard items(*m_currentMenu);
+
+            if (syncCursor(items) == 0) {
+                return;
+            }
+            MENULIB_INSTRUMENT(items.at(m_currentIndex), Select);
+
+            items.at(m_currentIndex)->onSelect(this);
     }
 
     void MenuNavigator::back() {
-        if (m_currentMenu->getParent()) {
-            m_currentIndex = 0;
-            setCurrentMenu(m_currentMenu->getParent());
+        MENULIB_INSTRUMENT(m_currentMenu, Back);
+        ascend();
+    }
+
+    int MenuNavigator::syncCursor(const MenuPage::ReadGuard& items) const{
+        if(m_frozen){
+            return static_cast<int>(m_frozen->getChildCount(m_frozenPage));
+        }
+        return syncItems(items, m_currentMenu->isLazy());
+    }
+
+    void MenuNavigator::trackCursor(const MenuPage::ReadGuard& items){
+        if(m_frozen){
+            followCursor();
+            return;
+        }
+        trackItems(items, m_currentMenu->isLazy());
+    }
+
+    void MenuNavigator::followCursor() const{
+        if(m_viewportSize <= 0){
+            m_viewportOffset = 0;
+            return;
+        }
+
+        if(m_currentIndex < m_viewportOffset){
+            m_viewportOffset = m_currentIndex;
+        }
+        else if(m_currentIndex >= m_viewportOffset + m_viewportSize){
+            m_viewportOffset = m_currentIndex - m_viewportSize + 1;
+        }
+    }
+
+    void MenuNavigator::setViewportSize(int rows){
+        if(rows < 0){
+            throw std::invalid_argument("MenuNavigator: Viewport size cannot be negative");
+        }
+        m_viewportSize = rows;
+        m_viewportOffset = 0;
+        followCursor();
+    }
+
+    int MenuNavigator::getViewportSize() const{
+        return m_viewportSize;
+    }
+
+    int MenuNavigator::getViewportOffset() const{
+        syncCount();
+        return m_viewportOffset;
+    }
+
+    int MenuNavigator::getViewportEnd() const{
+        int count = syncCount();
+
+        if(m_viewportSize <= 0 || m_viewportOffset + m_viewportSize > count){
+            return count;
+        }
+        return m_viewportOffset + m_viewportSize;
+    }
+
+    void MenuNavigator::pageUp(){
+        moveCursor([this](int index, int count){
+            // without a viewport the whole page is one screen
+            int rows = m_viewportSize > 0 ? m_viewportSize : count;
+            return index - rows < 0 ? 0 : index - rows;
+        });
+    }
+
+    void MenuNavigator::pageDown(){
+        moveCursor([this](int index, int count){
+            int rows = m_viewportSize > 0 ? m_viewportSize : count;
+            return index + rows >= count ? count - 1 : index + rows;
+        });
+    }
+
+    void MenuNavigator::first(){
+        moveCursor([](int, int){
+            return 0;
+        });
+    }
+
+    void MenuNavigator::last(){
+        moveCursor([](int, int count){
+            return count - 1;
+        });
+    }
+
+    void MenuNavigator::move(int delta){
+        moveCursor([delta](int index, int count){
+            return (index + delta % count + count) % count;
+        });
+    }
+
+    void MenuNavigator::step(int steps){
+        if (m_frozen){
+            if (steps != 0 && m_frozen->getChildCount(m_frozenPage) != 0){
+                std::uint32_t node = m_frozen->getChild(m_frozenPage, m_currentIndex);
+                MENULIB_INSTRUMENT_STEPS(m_frozen->getSource(node), steps);
+                m_frozen->step(node, this, steps);
+            }
+            return;
+        }
+
+        if (m_variantMenu){
+            if (steps != 0 && syncItems(*m_variantMenu, false) != 0){
+                MENULIB_INSTRUMENT_STEPS(m_variantMenu->at(m_currentIndex), steps);
+                m_variantMenu->stepAt(m_currentIndex, this, steps);
+            }
+            return;
+        }
+
+        MenuPage::ReadGuard items(*m_currentMenu);
+
+        if (steps == 0 || syncCursor(items) == 0){
+            return;
+        }
+        MENULIB_INSTRUMENT_STEPS(items.at(m_currentIndex), steps);
+
+        items.at(m_currentIndex)->onStep(this, steps);
+    }
+
+    void MenuNavigator::dispatch(MenuEvent event){
+        switch (event) {
+            case MenuEvent::Next: next(); break;
+            case MenuEvent::Previous: previous(); break;
+            case MenuEvent::Left: left(); break;
+            case MenuEvent::Right: right(); break;
+            case MenuEvent::Select: select(); break;
+            case MenuEvent::Back: back(); break;
         }
     }
 
@@ -100,31 +659,67 @@ namespace mr{
     }
 
     void MenuNavigator::left(){
+        if (m_frozen){
+            if (m_frozen->getChildCount(m_frozenPage) != 0){
+                std::uint32_t node = m_frozen->getChild(m_frozenPage, m_currentIndex);
+                MENULIB_INSTRUMENT(m_frozen->getSource(node), Left);
+                m_frozen->left(node, this);
+            }
+            return;
+        }
+
         if (!m_currentMenu){
             return;
         }
 
-        const std::vector<IMenuItem*>& items = m_currentMenu->getItems();
+        if (m_variantMenu){
+            if (syncItems(*m_variantMenu, false) != 0) {
+                MENULIB_INSTRUMENT(m_variantMenu->at(m_currentIndex), Left);
+                m_variantMenu->leftAt(m_currentIndex, this);
+            }
+            return;
+        }
 
-        if (items.empty()) {
+        MenuPage::ReadGuard items(*m_currentMenu);
+
+        if (syncCursor(items) == 0) {
             return;
         }
+        MENULIB_INSTRUMENT(items.at(m_currentIndex), Left);
 
-        items[m_currentIndex]->onLeft(this);
+        items.at(m_currentIndex)->onLeft(this);
     }
 
     void MenuNavigator::right(){
+        if (m_frozen){
+            if (m_frozen->getChildCount(m_frozenPage) != 0){
+                std::uint32_t node = m_frozen->getChild(m_frozenPage, m_currentIndex);
+                MENULIB_INSTRUMENT(m_frozen->getSource(node), Right);
+                m_frozen->right(node, this);
+            }
+            return;
+        }
+
         if (!m_currentMenu){
             return;
         }
 
-        const std::vector<IMenuItem*>& items = m_currentMenu->getItems();
+        if (m_variantMenu){
+            if (syncItems(*m_variantMenu, false) != 0) {
+                MENULIB_INSTRUMENT(m_variantMenu->at(m_currentIndex), Right);
+                m_variantMenu->rightAt(m_currentIndex, this);
+            }
+            return;
+        }
+
+        MenuPage::ReadGuard items(*m_currentMenu);
 
-        if (items.empty()) {
+        if (syncCursor(items) == 0) {
             return;
         }
+        MENULIB_INSTRUMENT(items.at(m_currentIndex), Right);
 
-        items[m_currentIndex]->onRight(this);
+        items.at(m_currentIndex)->onRight(this);
     }
 
 
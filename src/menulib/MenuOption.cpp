@@ -1,35 +1,191 @@
 #include "menulib/MenuOption.hpp"
+#include "menulib/MenuStats.hpp"
 
 namespace mr{
 
-    MenuOption::MenuOption(const std::string& label) : IMenuItem(label), m_func(nullptr){
+    namespace{
+        /**
+        * @brief Cancel flag of the asynchronous action running on this thread.
+        */
+        thread_local const std::atomic<bool>* t_cancelFlag = nullptr;
+    }
+
+    MenuOption::MenuOption(std::string_view label, std::pmr::memory_resource* resource)
+        : IMenuItem(label, resource), m_func(nullptr){
         if(label.empty()){
             throw std::invalid_argument("MenuOption: Label cannot be empty");
         }
     }
 
-    MenuOption::MenuOption(const std::string& label, const std::function<void()>& func) : IMenuItem(label), m_func(func){
+    MenuOption::MenuOption(std::string_view label, MenuCallback<void()> func, std::pmr::memory_resource* resource)
+        : IMenuItem(label, resource), m_func(std::move(func)){
         if(label.empty()){
             throw std::invalid_argument("MenuOption: Label cannot be empty");
         }
-        if(!func){
+        if(!m_func){
             throw std::invalid_argument("MenuOption: Function cannot be null");
         }
     }
 
+    MenuOption::~MenuOption(){
+        if(!m_async){
+            return;
+        }
+
+        // queued jobs see the detached flag and skip, a running one is waited for
+        std::unique_lock<std::mutex> lock(m_async->mutex);
+        m_async->detached = true;
+        m_async->cancelRequested = true;
+        m_async->finished.wait(lock, [this]{ return !m_async->running; });
+    }
+
     void MenuOption::execute() const {
         if(m_func)
         {
+            MENULIB_INSTRUMENT(this, Callback);
             m_func();
         }
     }
 
+    void MenuOption::setAsync(MenuThreadPool* pool, ReselectPolicy policy){
+        m_pool = pool;
+        m_policy = policy;
+
+        if(pool && !m_async){
+            m_async = std::make_shared<AsyncState>();
+        }
+    }
+
+    ActionStatus MenuOption::getStatus() const{
+        return m_async ? m_async->status.load() : ActionStatus::Idle;
+    }
+
+    void MenuOption::wait() const{
+        if(!m_async){
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_async->mutex);
+        m_async->finished.wait(lock, [this]{
+            ActionStatus status = m_async->status.load();
+            return status != ActionStatus::Pending && status != ActionStatus::Running;
+        });
+    }
+
+    bool MenuOption::cancellationRequested(){
+        return t_cancelFlag != nullptr && t_cancelFlag->load();
+    }
+
+    void MenuOption::runJob(const std::shared_ptr<AsyncState>& state, MenuOption* option){
+        std::unique_lock<std::mutex> lock(state->mutex);
+
+        while(!state->detached){
+            state->running = true;
+            state->rerun = false;
+            state->cancelRequested = false;
+            state->status = ActionStatus::Running;
+            lock.unlock();
+            option->notifyLabelChanged();
+
+            ActionStatus result = ActionStatus::Done;
+            t_cancelFlag = &state->cancelRequested;
+            try{
+                option->execute();
+            }
+            catch(...){
+                result = ActionStatus::Failed;
+            }
+            t_cancelFlag = nullptr;
+
+            lock.lock();
+            state->status = result;
+            lock.unlock();
+
+            // announced while still running, the destructor waits until then
+            option->notifyLabelChanged();
+
+            lock.lock();
+            state->running = false;
+            if(!state->rerun){
+                break;
+            }
+        }
+
+        if(state->detached && state->status == ActionStatus::Pending){
+            state->status = ActionStatus::Idle;
+        }
+        state->finished.notify_all();
+    }
+
     void MenuOption::onSelect(MenuNavigator* navigator){
-        MenuOption::execute();
+        if(!m_pool){
+            MenuOption::execute();
+            return;
+        }
+
+        std::shared_ptr<AsyncState> state = m_async;
+        bool submit = false;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+
+            ActionStatus status = state->status.load();
+            if(status == ActionStatus::Pending){
+                // the queued run has not started yet, it already covers this selection
+                return;
+            }
+            if(status == ActionStatus::Running){
+                if(m_policy == ReselectPolicy::Cancel){
+                    state->cancelRequested = true;
+                    state->rerun = true;
+                }
+                return;
+            }
+
+            state->status = ActionStatus::Pending;
+            submit = !state->running;
+            if(!submit){
+                // the job is announcing the finished run, it runs the action again
+                state->rerun = true;
+            }
+        }
+
+        // announced before queuing, so observers see the statuses in order
+        notifyLabelChanged();
+        if(submit){
+            m_pool->submit([state, this]{ runJob(state, this); });
+        }
+    }
+
+    void MenuOption::appendLabel(std::string& out) const{
+        std::string_view base = getBaseLabel();
+        out.append(base.data(), base.size());
+
+        if(!m_pool){
+            return;
+        }
+
+        switch(getStatus()){
+            case ActionStatus::Pending: out += " [queued]"; break;
+            case ActionStatus::Running: out += " [running]"; break;
+            case ActionStatus::Done: out += " [done]"; break;
+            case ActionStatus::Failed: out += " [failed]"; break;
+            case ActionStatus::Idle: break;
+        }
+    }
+
+    std::string_view MenuOption::getLabel() const{
+        if(!m_pool){
+            return getBaseLabel();
+        }
+        return composeLabel(m_labelCache);
     }
 
     bool MenuOption::isEnd() const {
         return true;
     }
 
+    ItemKind MenuOption::getKind() const {
+        return ItemKind::Option;
+    }
+
 }
@@ -1,12 +1,40 @@
 #include "menulib/MenuPage.hpp"
 #include "menulib/IMenuItem.hpp"
 #include "menulib/MenuNavigator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 namespace mr{
 
-    MenuPage::MenuPage() : IMenuItem("New Page"), m_parent(nullptr){}
+    namespace{
 
-    MenuPage::MenuPage(const std::string& label, MenuPage* parent) : IMenuItem(label), m_parent(parent){
+        /**
+        * @brief Lock behind MenuPage::ObserverLock, leaked so pages destroyed during exit can still use it.
+        */
+        std::recursive_mutex& observerMutex(){
+            static std::recursive_mutex* mutex = new std::recursive_mutex();
+            return *mutex;
+        }
+
+        /**
+        * @brief Count of observers attached to any page, notifications skip the lock while it is 0.
+        */
+        std::atomic<int> attachedObservers {};
+    }
+
+    MenuPage::ObserverLock::ObserverLock(){
+        observerMutex().lock();
+    }
+
+    MenuPage::ObserverLock::~ObserverLock(){
+        observerMutex().unlock();
+    }
+
+    MenuPage::MenuPage() : IMenuItem("New Page"), m_items(getResource()), m_parent(nullptr), m_observers(getResource()){}
+
+    MenuPage::MenuPage(std::string_view label, MenuPage* parent, std::pmr::memory_resource* resource)
+        : IMenuItem(label, resource), m_items(resource), m_parent(parent), m_observers(resource){
         if(label.empty()){
             throw std::invalid_argument("MenuPage: Label cannot be empty");
         }
@@ -14,8 +42,11 @@ namespace mr{
 
     MenuPage::~MenuPage() {
         // Clean up all child items to prevent memory leaks.
+        // Arena items are destroyed by their arena, so they are skipped here.
         for (IMenuItem* item : m_items) {
-            delete item;
+            if (!item->isArenaAllocated()) {
+                delete item;
+            }
         }
     }
 
@@ -24,18 +55,158 @@ namespace mr{
             throw std::invalid_argument("MenuPage: Cannot add null item");
         }
         m_items.push_back(item);
+        adopt(item);
+        notifyItemAdded(item);
+    }
+
+    bool MenuPage::removeItem(IMenuItem* item){
+        if (!detachItem(item)) {
+            return false;
+        }
+
+        if (!item->isArenaAllocated()) {
+            delete item;
+        }
+        return true;
     }
 
-    const std::vector<IMenuItem*>& MenuPage::getItems() const {
+    bool MenuPage::detachItem(IMenuItem* item){
+        auto it = std::find(m_items.begin(), m_items.end(), item);
+        if (it == m_items.end()) {
+            return false;
+        }
+        m_items.erase(it);
+        notifyItemRemoved(item);
+        return true;
+    }
+
+    void MenuPage::detachItems(){
+        m_items.clear();
+    }
+
+    void MenuPage::adopt(IMenuItem* item){
+        item->m_owner = this;
+
+        if (item->getKind() == ItemKind::Page) {
+            MenuPage* page = static_cast<MenuPage*>(item);
+            if (!page->m_parent) {
+                page->m_parent = this;
+            }
+        }
+    }
+
+    template <typename F>
+    void MenuPage::forEachObserver(F f){
+        if (attachedObservers.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+
+        ObserverLock lock;
+        for (MenuPage* page = this; page != nullptr; page = page->getOwner()) {
+            // by index, a callback may attach or detach observers
+            for (std::size_t i = 0; i < page->m_observers.size(); ++i) {
+                f(page->m_observers[i]);
+            }
+        }
+    }
+
+    void MenuPage::notifyItemAdded(IMenuItem* item){
+        forEachObserver([this, item](IMenuObserver* observer){
+            observer->onItemAdded(this, item);
+        });
+    }
+
+    void MenuPage::notifyItemRemoved(IMenuItem* item){
+        forEachObserver([this, item](IMenuObserver* observer){
+            observer->onItemRemoved(this, item);
+        });
+    }
+
+    const void* MenuPage::acquireItems() const{
+        return nullptr;
+    }
+
+    void MenuPage::releaseItems(const void* pin) const{}
+
+    int MenuPage::pinnedCount(const void* pin) const{
+        return static_cast<int>(m_items.size());
+    }
+
+    IMenuItem* MenuPage::pinnedItem(const void* pin, int index) const{
+        return m_items[index];
+    }
+
+    int MenuPage::pinnedIndexOf(const void* pin, const IMenuItem* item) const{
+        int count = pinnedCount(pin);
+        for (int i = 0; i < count; ++i) {
+            if (pinnedItem(pin, i) == item) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool MenuPage::isLazy() const{
+        return false;
+    }
+
+    void MenuPage::prefetch(){}
+
+    bool MenuPage::isPrefetched() const{
+        return true;
+    }
+
+    std::function<void()> MenuPage::prefetchTask(){
+        return [this]{
+            prefetch();
+        };
+    }
+
+    void MenuPage::populate(){}
+
+    void MenuPage::addObserver(IMenuObserver* observer){
+        if (!observer) {
+            throw std::invalid_argument("MenuPage: Cannot add null observer");
+        }
+        ObserverLock lock;
+        m_observers.push_back(observer);
+        attachedObservers.fetch_add(1, std::memory_order_release);
+    }
+
+    void MenuPage::removeObserver(IMenuObserver* observer){
+        ObserverLock lock;
+        auto removed = std::remove(m_observers.begin(), m_observers.end(), observer);
+        attachedObservers.fetch_sub(static_cast<int>(m_observers.end() - removed), std::memory_order_release);
+        m_observers.erase(removed, m_observers.end());
+    }
+
+    void MenuPage::notifyLabelChanged(IMenuItem* item){
+        forEachObserver([item](IMenuObserver* observer){
+            observer->onLabelChanged(item);
+        });
+    }
+
+    void MenuPage::notifyValueChanged(IMenuItem* item){
+        forEachObserver([item](IMenuObserver* observer){
+            observer->onValueChanged(item);
+        });
+    }
+
+    const std::pmr::vector<IMenuItem*>& MenuPage::getItems() const {
         return m_items;
     }
 
     IMenuItem* MenuPage::getItem(int index) const{
-        return m_items.at(index);
+        ReadGuard guard(*this);
+        if (index < 0 || index >= guard.count()) {
+            throw std::out_of_range("MenuPage: Item index out of range");
+        }
+        return guard.at(index);
     }
 
     int MenuPage::getCount() const{
-        return m_items.size();
+        ReadGuard guard(*this);
+        return guard.count();
     }
 
     MenuPage* MenuPage::getParent() const{
@@ -50,4 +221,8 @@ namespace mr{
         navigator->setCurrentMenu(this);
     }
 
+    ItemKind MenuPage::getKind() const {
+        return ItemKind::Page;
+    }
+
 }
@@ -0,0 +1,208 @@
+#include "menulib/MenuPaths.hpp"
+#include <algorithm>
+
+namespace mr{
+
+    namespace{
+
+        /**
+        * @brief Builds the path of a node from its page's prefix, its label and its number.
+        */
+        void buildPath(MenuPaths::Node& node, const std::string& prefix){
+            node.path = prefix;
+            MenuPaths::appendLabel(node.path, node.label);
+            if(node.number > 1){
+                node.path += '#';
+                node.path += std::to_string(node.number);
+            }
+        }
+    }
+
+    void MenuPaths::appendLabel(std::string& path, std::string_view label){
+        for(char c : label){
+            if(c == '/' || c == '#' || c == '\\'){
+                path += '\\';
+            }
+            path += c;
+        }
+    }
+
+    MenuPaths::MenuPaths(MenuPage* root) : m_root(root) {}
+
+    std::string MenuPaths::prefixOf(const MenuPage* page) const{
+        if(page == m_root){
+            return std::string();
+        }
+        return m_nodes.at(page).path + '/';
+    }
+
+    void MenuPaths::addChild(Siblings& siblings, MenuPage* page, IMenuItem* item, Listener& listener){
+        auto [it, inserted] = m_nodes.try_emplace(item);
+        if(!inserted){
+            return;
+        }
+
+        // items are only ever appended, so the node takes the last index and the next number of its label
+        Node& node = it->second;
+        node.item = item;
+        node.page = page;
+        node.index = static_cast<int>(siblings.items.size());
+        node.label = item->getBaseLabel();
+        siblings.items.push_back(&node);
+
+        std::vector<Node*>& group = siblings.byLabel[node.label];
+        group.push_back(&node);
+        node.number = static_cast<int>(group.size());
+
+        buildPath(node, prefixOf(page));
+        listener.pathAdded(node, false);
+
+        if(item->getKind() == ItemKind::Page && !static_cast<MenuPage*>(item)->isLazy()){
+            addChildren(static_cast<MenuPage*>(item), listener);
+        }
+    }
+
+    void MenuPaths::addChildren(MenuPage* page, Listener& listener){
+        // element references survive rehashing, so the siblings stay valid while deeper pages are added
+        Siblings& siblings = m_pages[page];
+        MenuPage::ReadGuard children(*page);
+        for(int i = 0; i < children.count(); ++i){
+            addChild(siblings, page, children.at(i), listener);
+        }
+    }
+
+    const MenuPaths::Siblings* MenuPaths::childrenOf(const IMenuItem* item) const{
+        if(item->getKind() != ItemKind::Page){
+            return nullptr;
+        }
+        auto page = m_pages.find(static_cast<const MenuPage*>(item));
+        return page != m_pages.end() ? &page->second : nullptr;
+    }
+
+    void MenuPaths::reportRemoved(const Node& node, bool renamed, Listener& listener) const{
+        listener.pathRemoved(node, renamed);
+
+        if(const Siblings* children = childrenOf(node.item)){
+            for(const Node* child : children->items){
+                reportRemoved(*child, renamed, listener);
+            }
+        }
+    }
+
+    void MenuPaths::assignPaths(Node& node, Listener& listener){
+        buildPath(node, prefixOf(node.page));
+        listener.pathAdded(node, true);
+
+        if(const Siblings* children = childrenOf(node.item)){
+            for(Node* child : children->items){
+                assignPaths(*child, listener);
+            }
+        }
+    }
+
+    void MenuPaths::forget(const Node& node){
+        const IMenuItem* item = node.item;
+
+        if(const Siblings* children = childrenOf(item)){
+            for(const Node* child : children->items){
+                forget(*child);
+            }
+            m_pages.erase(static_cast<const MenuPage*>(item));
+        }
+        m_nodes.erase(item);
+    }
+
+    void MenuPaths::rename(const std::vector<Node*>& nodes, Listener& listener){
+        // all old paths go first, a node may take over the path of another one
+        for(const Node* node : nodes){
+            reportRemoved(*node, true, listener);
+        }
+        for(Node* node : nodes){
+            assignPaths(*node, listener);
+        }
+    }
+
+    void MenuPaths::build(Listener& listener){
+        addChildren(m_root, listener);
+    }
+
+    void MenuPaths::add(MenuPage* page, IMenuItem* item, Listener& listener){
+        auto siblings = m_pages.find(page);
+        if(siblings != m_pages.end()){
+            addChild(siblings->second, page, item, listener);
+        }
+    }
+
+    void MenuPaths::remove(MenuPage* page, IMenuItem* item, Listener& listener){
+        auto it = m_nodes.find(item);
+        if(it == m_nodes.end() || it->second.page != page){
+            return;
+        }
+        Node& node = it->second;
+        Siblings& siblings = m_pages.at(page);
+        reportRemoved(node, false, listener);
+
+        // later siblings sharing the label move down a number
+        auto group = siblings.byLabel.find(node.label);
+        std::vector<Node*> later(group->second.begin() + node.number, group->second.end());
+        for(Node* sibling : later){
+            sibling->number--;
+        }
+        group->second.erase(group->second.begin() + (node.number - 1));
+        if(group->second.empty()){
+            siblings.byLabel.erase(group);
+        }
+
+        siblings.items.erase(siblings.items.begin() + node.index);
+        for(std::size_t i = static_cast<std::size_t>(node.index); i < siblings.items.size(); ++i){
+            siblings.items[i]->index--;
+        }
+
+        forget(node);
+        rename(later, listener);
+    }
+
+    void MenuPaths::relabel(IMenuItem* item, Listener& listener){
+        auto it = m_nodes.find(item);
+        if(it == m_nodes.end() || it->second.label == item->getBaseLabel()){
+            return;
+        }
+        Node& node = it->second;
+        Siblings& siblings = m_pages.at(node.page);
+        std::vector<Node*> renamed {&node};
+
+        // siblings after it under the old label move down a number
+        auto previous = siblings.byLabel.find(node.label);
+        for(auto sibling = previous->second.begin() + node.number; sibling != previous->second.end(); ++sibling){
+            (*sibling)->number--;
+            renamed.push_back(*sibling);
+        }
+        previous->second.erase(previous->second.begin() + (node.number - 1));
+        if(previous->second.empty()){
+            siblings.byLabel.erase(previous);
+        }
+
+        // and those after it under the new label move up one
+        node.label = item->getBaseLabel();
+        std::vector<Node*>& group = siblings.byLabel[node.label];
+        auto position = std::lower_bound(group.begin(), group.end(), node.index,
+                                         [](const Node* sibling, int index){ return sibling->index < index; });
+        position = group.insert(position, &node);
+        node.number = static_cast<int>(position - group.begin()) + 1;
+        for(++position; position != group.end(); ++position){
+            (*position)->number++;
+            renamed.push_back(*position);
+        }
+
+        rename(renamed, listener);
+    }
+
+    const MenuPaths::Node* MenuPaths::find(const IMenuItem* item) const{
+        auto it = m_nodes.find(item);
+        return it != m_nodes.end() ? &it->second : nullptr;
+    }
+
+    std::size_t MenuPaths::size() const{
+        return m_nodes.size();
+    }
+}
@@ -0,0 +1,85 @@
+#include "menulib/MenuPrefetcher.hpp"
+#include <stdexcept>
+
+namespace mr{
+
+    MenuPrefetcher::MenuPrefetcher(MenuThreadPool* pool, Clock::duration dwell, std::size_t maxInFlight)
+        : m_pool(pool), m_dwell(dwell), m_maxInFlight(maxInFlight), m_jobs(std::make_shared<Jobs>()){
+        if(pool == nullptr){
+            throw std::invalid_argument("MenuPrefetcher: Pool cannot be nullptr");
+        }
+        if(maxInFlight == 0){
+            throw std::invalid_argument("MenuPrefetcher: Concurrency limit must be positive");
+        }
+        if(dwell < Clock::duration::zero()){
+            throw std::invalid_argument("MenuPrefetcher: Dwell time cannot be negative");
+        }
+    }
+
+    MenuPrefetcher::~MenuPrefetcher(){
+        wait();
+    }
+
+    bool MenuPrefetcher::update(const MenuNavigator& navigator, Clock::time_point now){
+        IMenuItem* item = navigator.getCurrentItem();
+        MenuPage* page = (item && item->getKind() == ItemKind::Page) ? static_cast<MenuPage*>(item) : nullptr;
+
+        if(page != m_candidate){
+            m_candidate = page;
+            m_since = now;
+            m_candidateStarted = false;
+        }
+
+        if(page == nullptr || m_candidateStarted || now - m_since < m_dwell){
+            return false;
+        }
+        if(page->isPrefetched()){
+            return false;
+        }
+        std::function<void()> task = page->prefetchTask();
+        if(!task){
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_jobs->mutex);
+            if(m_jobs->inFlight >= m_maxInFlight || m_jobs->pages.count(page) != 0){
+                return false;
+            }
+            m_jobs->inFlight++;
+            m_jobs->pages.insert(page);
+        }
+        m_candidateStarted = true;
+        m_startedCount++;
+
+        // the task keeps what it needs alive, the page may be destroyed before it runs
+        std::shared_ptr<Jobs> jobs = m_jobs;
+        m_pool->submit([jobs, page, task = std::move(task)]{
+            // a failed prefetch is repeated by populate() on the navigating thread
+            try{
+                task();
+            }
+            catch(...){}
+
+            std::lock_guard<std::mutex> lock(jobs->mutex);
+            jobs->pages.erase(page);
+            jobs->inFlight--;
+            jobs->finished.notify_all();
+        });
+        return true;
+    }
+
+    void MenuPrefetcher::wait(){
+        std::unique_lock<std::mutex> lock(m_jobs->mutex);
+        m_jobs->finished.wait(lock, [this]{ return m_jobs->inFlight == 0; });
+    }
+
+    std::size_t MenuPrefetcher::getInFlightCount() const{
+        std::lock_guard<std::mutex> lock(m_jobs->mutex);
+        return m_jobs->inFlight;
+    }
+
+    std::size_t MenuPrefetcher::getStartedCount() const{
+        return m_startedCount;
+    }
+}
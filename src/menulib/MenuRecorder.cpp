@@ -0,0 +1,145 @@
+#include "menulib/MenuRecorder.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace mr{
+
+    namespace{
+        constexpr char Magic[8] = {'M', 'E', 'N', 'U', 'T', 'R', 'C', '\0'};
+
+        constexpr std::size_t HeaderSize = sizeof(Magic) + 4 + 8;
+
+        [[noreturn]] void malformed(const char* what){
+            throw std::runtime_error(std::string("MenuRecorder: Malformed trace, ") + what);
+        }
+
+        void putLittleEndian(std::string& out, std::uint64_t value, int bytes){
+            for(int i = 0; i < bytes; ++i){
+                out += static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+        }
+
+        std::uint64_t getLittleEndian(const unsigned char* in, int bytes){
+            std::uint64_t value = 0;
+            for(int i = 0; i < bytes; ++i){
+                value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        void putVarint(std::string& out, std::uint64_t value){
+            while(value >= 0x80){
+                out += static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+    }
+
+    void MenuRecorder::record(MenuEvent event){
+        std::chrono::microseconds elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
+        std::uint64_t timeUs = static_cast<std::uint64_t>(elapsed.count());
+
+        // the clock is monotonic, but a time given to the other overload may be ahead of it
+        if(!m_events.empty() && timeUs < m_events.back().timeUs){
+            timeUs = m_events.back().timeUs;
+        }
+        m_events.push_back({event, timeUs});
+    }
+
+    void MenuRecorder::record(MenuEvent event, std::uint64_t timeUs){
+        if(!m_events.empty() && timeUs < m_events.back().timeUs){
+            throw std::invalid_argument("MenuRecorder: Event time cannot go back");
+        }
+        m_events.push_back({event, timeUs});
+    }
+
+    void MenuRecorder::restart(){
+        m_events.clear();
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    const std::vector<TraceEvent>& MenuRecorder::getEvents() const{
+        return m_events;
+    }
+
+    void MenuRecorder::save(const std::string& path) const{
+        std::string data(Magic, sizeof(Magic));
+        putLittleEndian(data, Version, 4);
+        putLittleEndian(data, m_events.size(), 8);
+
+        std::uint64_t previous = 0;
+        for(const TraceEvent& entry : m_events){
+            data += static_cast<char>(entry.event);
+            putVarint(data, entry.timeUs - previous);
+            previous = entry.timeUs;
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        out.close();
+
+        if(!out){
+            throw std::runtime_error("MenuRecorder: Cannot write " + path);
+        }
+    }
+
+    std::vector<TraceEvent> MenuRecorder::load(const std::string& path){
+        std::ifstream input(path, std::ios::binary);
+        if(!input){
+            throw std::runtime_error("MenuRecorder: Cannot open " + path);
+        }
+        std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(content.data());
+        std::size_t size = content.size();
+
+        if(size < HeaderSize || std::memcmp(data, Magic, sizeof(Magic)) != 0){
+            malformed("not a trace file");
+        }
+        if(getLittleEndian(data + 8, 4) != Version){
+            malformed("unsupported version");
+        }
+        std::uint64_t count = getLittleEndian(data + 12, 8);
+
+        // every event takes at least two bytes, so a bad count cannot make us reserve much
+        if(count > (size - HeaderSize) / 2){
+            malformed("truncated events");
+        }
+
+        std::vector<TraceEvent> events;
+        events.reserve(static_cast<std::size_t>(count));
+
+        std::size_t at = HeaderSize;
+        std::uint64_t time = 0;
+        for(std::uint64_t i = 0; i < count; ++i){
+            if(at >= size || data[at] > static_cast<unsigned char>(MenuEvent::Back)){
+                malformed("invalid event");
+            }
+            MenuEvent event = static_cast<MenuEvent>(data[at++]);
+
+            std::uint64_t delta = 0;
+            for(int shift = 0;; shift += 7){
+                if(at >= size || shift > 63){
+                    malformed("invalid time");
+                }
+                unsigned char byte = data[at++];
+                delta |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if((byte & 0x80) == 0){
+                    break;
+                }
+            }
+
+            time += delta;
+            events.push_back({event, time});
+        }
+
+        if(at != size){
+            malformed("trailing data");
+        }
+        return events;
+    }
+}
@@ -0,0 +1,169 @@
+#include "menulib/MenuRenderer.hpp"
+#include <algorithm>
+
+namespace mr{
+
+    namespace{
+        /**
+        * @brief Counts terminal columns of an UTF-8 string (one per code point).
+        */
+        std::size_t columnsOf(std::string_view text){
+            std::size_t columns = 0;
+            for(unsigned char c : text){
+                if((c & 0xC0) != 0x80){
+                    columns++;
+                }
+            }
+            return columns;
+        }
+
+        /**
+        * @brief Returns length of the common prefix, never splitting an UTF-8 sequence.
+        */
+        std::size_t commonPrefix(std::string_view a, std::string_view b){
+            std::size_t n = std::min(a.size(), b.size());
+            std::size_t i = 0;
+            while(i < n && a[i] == b[i]){
+                i++;
+            }
+            while(i > 0 && i < a.size() && (static_cast<unsigned char>(a[i]) & 0xC0) == 0x80){
+                i--;
+            }
+            return i;
+        }
+    }
+
+    std::string& MenuRenderer::lineAt(std::size_t i){
+        if(i >= m_current.size()){
+            m_current.resize(i + 1);
+        }
+        m_current[i].clear();
+        return m_current[i];
+    }
+
+    std::size_t MenuRenderer::buildFrame(const MenuNavigator& navigator){
+        std::size_t lines = 0;
+
+        std::string& title = lineAt(lines++);
+        title += "--- ";
+        title += navigator.getCurrentTitle();
+        title += " ---";
+        lineAt(lines++);
+
+        // the pin keeps the rows consistent and their labels alive while the frame is built,
+        // even if other threads change the page meanwhile
+        MenuPage::ReadGuard items(*navigator.getCurrentMenu());
+
+        int index = navigator.getCurrentIndex();
+        int end = navigator.getViewportEnd();
+        if(!navigator.isFrozen() && end > items.count()){
+            end = items.count();
+        }
+
+        // only the rows inside the viewport are formatted
+        for(int i = navigator.getViewportOffset(); i < end; ++i){
+            std::string& line = lineAt(lines++);
+            line += (i == index) ? " > " : "   ";
+            if(navigator.isFrozen()){
+                line += navigator.getCurrentLabel(i);
+            }
+            else{
+                items.at(i)->appendLabel(line);
+            }
+            if(i == index){
+                line += " <";
+            }
+        }
+
+        for(const std::string& footer : m_footer){
+            lineAt(lines++) += footer;
+        }
+
+        return lines;
+    }
+
+    void MenuRenderer::moveTo(std::size_t row, std::size_t column){
+        m_output += "\x1b[";
+        m_output += std::to_string(row);
+        m_output += ';';
+        m_output += std::to_string(column);
+        m_output += 'H';
+    }
+
+    void MenuRenderer::setFooter(const std::vector<std::string>& lines){
+        m_footer = lines;
+        m_fullRedraw = true;
+    }
+
+    std::size_t MenuRenderer::render(const MenuNavigator& navigator, std::ostream& out){
+        std::size_t lines = buildFrame(navigator);
+        std::size_t previousLines = m_fullRedraw ? 0 : m_previous.size();
+
+        m_output.clear();
+        m_lastChangedLines = 0;
+
+        if(m_fullRedraw){
+            m_output += "\x1b[H\x1b[2J";
+        }
+
+        for(std::size_t i = 0; i < std::max(lines, previousLines); ++i){
+            if(i >= lines){
+                // the new frame is shorter, wipe leftovers
+                moveTo(i + 1, 1);
+                m_output += "\x1b[2K";
+                m_lastChangedLines++;
+                continue;
+            }
+
+            std::string_view now = m_current[i];
+            std::size_t from = 0;
+
+            if(i < previousLines){
+                std::string_view before = m_previous[i];
+                if(now == before){
+                    continue;
+                }
+                from = commonPrefix(now, before);
+            }
+
+            moveTo(i + 1, columnsOf(now.substr(0, from)) + 1);
+            m_output.append(now.data() + from, now.size() - from);
+            m_output += "\x1b[K";
+            m_lastChangedLines++;
+        }
+
+        // leave the terminal cursor at the end of the last line (e.g. an input prompt)
+        if(lines > 0){
+            moveTo(lines, columnsOf(m_current[lines - 1]) + 1);
+        }
+
+        out.write(m_output.data(), static_cast<std::streamsize>(m_output.size()));
+        out.flush();
+
+        // keep the drawn lines, the old buffers are reused for the next frame
+        m_current.resize(lines);
+        std::swap(m_previous, m_current);
+        m_fullRedraw = false;
+
+        m_lastFrameBytes = m_output.size();
+        m_totalBytes += m_lastFrameBytes;
+        return m_lastFrameBytes;
+    }
+
+    void MenuRenderer::invalidate(){
+        m_fullRedraw = true;
+    }
+
+    std::size_t MenuRenderer::getLastFrameBytes() const{
+        return m_lastFrameBytes;
+    }
+
+    std::size_t MenuRenderer::getLastChangedLines() const{
+        return m_lastChangedLines;
+    }
+
+    std::size_t MenuRenderer::getTotalBytes() const{
+        return m_totalBytes;
+    }
+
+}
@@ -0,0 +1,103 @@
+#include "menulib/MenuReplayer.hpp"
+#include "menulib/IMenuSlider.hpp"
+#include "menulib/MenuToggle.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace mr{
+
+    namespace{
+
+        /**
+        * @brief 64-bit FNV-1a, fed byte by byte.
+        */
+        class Fnv1a{
+            private:
+                std::uint64_t m_hash {14695981039346656037ull};
+
+            public:
+                void add(const void* data, std::size_t size){
+                    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                    for(std::size_t i = 0; i < size; ++i){
+                        m_hash ^= bytes[i];
+                        m_hash *= 1099511628211ull;
+                    }
+                }
+
+                std::uint64_t get() const{
+                    return m_hash;
+                }
+        };
+
+        void hashSubtree(Fnv1a& hash, const IMenuItem* item){
+            ItemKind kind = item->getKind();
+            hash.add(&kind, sizeof(kind));
+
+            if(kind == ItemKind::Toggle){
+                std::uint8_t state = static_cast<const MenuToggle*>(item)->getState() ? 1 : 0;
+                hash.add(&state, sizeof(state));
+            }
+            else if(kind == ItemKind::Slider){
+                // +0.0 so that -0.0 hashes the same
+                double value = static_cast<const IMenuSlider*>(item)->getNumericValue() + 0.0;
+                std::uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                hash.add(&bits, sizeof(bits));
+            }
+            else if(kind == ItemKind::Page && !static_cast<const MenuPage*>(item)->isLazy()){
+                MenuPage::ReadGuard children(*static_cast<const MenuPage*>(item));
+                std::uint32_t count = static_cast<std::uint32_t>(children.count());
+                hash.add(&count, sizeof(count));
+                for(int i = 0; i < children.count(); ++i){
+                    hashSubtree(hash, children.at(i));
+                }
+            }
+        }
+    }
+
+    MenuReplayer::MenuReplayer(std::vector<TraceEvent> events) : m_events(std::move(events)){}
+
+    MenuReplayer::MenuReplayer(const std::string& path) : m_events(MenuRecorder::load(path)){}
+
+    ReplayResult MenuReplayer::replay(MenuNavigator* navigator, Speed speed) const{
+        if(navigator == nullptr){
+            throw std::invalid_argument("MenuReplayer: Navigator cannot be nullptr");
+        }
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start = Clock::now();
+
+        for(const TraceEvent& entry : m_events){
+            if(speed == Speed::Recorded){
+                std::this_thread::sleep_until(start + std::chrono::microseconds(entry.timeUs));
+            }
+            navigator->dispatch(entry.event);
+        }
+
+        ReplayResult result;
+        result.events = m_events.size();
+        result.elapsed = Clock::now() - start;
+
+        double seconds = std::chrono::duration<double>(result.elapsed).count();
+        result.eventsPerSecond = seconds > 0.0 ? static_cast<double>(result.events) / seconds : 0.0;
+
+        const MenuPage* root = navigator->getCurrentMenu();
+        while(root != nullptr && root->getParent() != nullptr){
+            root = root->getParent();
+        }
+        result.stateHash = root != nullptr ? stateHash(root) : 0;
+        return result;
+    }
+
+    const std::vector<TraceEvent>& MenuReplayer::getEvents() const{
+        return m_events;
+    }
+
+    std::uint64_t MenuReplayer::stateHash(const MenuPage* root){
+        Fnv1a hash;
+        hashSubtree(hash, root);
+        return hash.get();
+    }
+}
@@ -0,0 +1,379 @@
+#include "menulib/MenuSearchIndex.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <mutex>
+#include <stdexcept>
+
+namespace mr{
+
+    namespace{
+        char lower(char c){
+            return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        bool isWordChar(char c){
+            return std::isalnum(static_cast<unsigned char>(c)) != 0;
+        }
+
+        std::string toLower(std::string_view text){
+            std::string result(text);
+            for(char& c : result){
+                c = lower(c);
+            }
+            return result;
+        }
+    }
+
+    MenuSearchIndex::MenuSearchIndex(MenuPage* root) : m_root(root){
+        if(root == nullptr){
+            throw std::invalid_argument("MenuSearchIndex: Root cannot be nullptr");
+        }
+
+        m_nodes.push_back(Node{npos, npos, '\0', {}});
+
+        // no change may slip in between indexing and attaching
+        MenuPage::ObserverLock observers;
+
+        // the root itself is not a search target, its whole subtree is
+        if(!root->isLazy()){
+            MenuPage::ReadGuard items(*root);
+            for(int i = 0; i < items.count(); ++i){
+                insertSubtree(items.at(i));
+            }
+        }
+        root->addObserver(this);
+    }
+
+    MenuSearchIndex::~MenuSearchIndex(){
+        m_root->removeObserver(this);
+    }
+
+    template <typename F>
+    void MenuSearchIndex::forEachKey(std::string_view label, F f){
+        for(std::size_t i = 0; i < label.size(); ++i){
+            if(isWordChar(label[i]) && (i == 0 || !isWordChar(label[i - 1]))){
+                f(trieKey(label.substr(i)));
+            }
+        }
+    }
+
+    std::string_view MenuSearchIndex::trieKey(std::string_view query){
+        std::size_t length = 0;
+        while(length < query.size() && length < MaxDepth && isWordChar(query[length])){
+            length++;
+        }
+        return query.substr(0, length);
+    }
+
+    bool MenuSearchIndex::matchesWord(std::string_view label, std::string_view query){
+        bool found = false;
+        forEachKey(label, [&](std::string_view key){
+            std::size_t start = static_cast<std::size_t>(key.data() - label.data());
+            if(!found && label.compare(start, query.size(), query) == 0){
+                found = true;
+            }
+        });
+        return found;
+    }
+
+    std::uint32_t MenuSearchIndex::findChild(std::uint32_t node, char key) const{
+        for(std::uint32_t child = m_nodes[node].firstChild; child != npos; child = m_nodes[child].nextSibling){
+            if(m_nodes[child].key == key){
+                return child;
+            }
+        }
+        return npos;
+    }
+
+    std::uint32_t MenuSearchIndex::findOrAddChild(std::uint32_t node, char key){
+        std::uint32_t child = findChild(node, key);
+        if(child != npos){
+            return child;
+        }
+
+        if(!m_freeNodes.empty()){
+            child = m_freeNodes.back();
+            m_freeNodes.pop_back();
+            m_nodes[child] = Node{npos, m_nodes[node].firstChild, key, {}};
+        }
+        else{
+            child = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.push_back(Node{npos, m_nodes[node].firstChild, key, {}});
+        }
+        m_nodes[node].firstChild = child;
+        return child;
+    }
+
+    std::uint32_t MenuSearchIndex::walk(std::uint32_t node, std::string_view key) const{
+        for(char c : key){
+            node = findChild(node, c);
+            if(node == npos){
+                return npos;
+            }
+        }
+        return node;
+    }
+
+    void MenuSearchIndex::insertItem(IMenuItem* item){
+        std::string& label = m_labels[item];
+        label = toLower(item->getBaseLabel());
+
+        forEachKey(label, [&](std::string_view key){
+            std::uint32_t node = 0;
+            for(char c : key){
+                node = findOrAddChild(node, c);
+            }
+
+            std::vector<IMenuItem*>& items = m_nodes[node].items;
+            if(std::find(items.begin(), items.end(), item) == items.end()){
+                items.push_back(item);
+            }
+        });
+    }
+
+    void MenuSearchIndex::eraseItem(const IMenuItem* item){
+        auto it = m_labels.find(item);
+        if(it == m_labels.end()){
+            return;
+        }
+
+        forEachKey(it->second, [&](std::string_view key){
+            eraseKey(key, item);
+        });
+
+        m_labels.erase(it);
+    }
+
+    void MenuSearchIndex::eraseKey(std::string_view key, const IMenuItem* item){
+        std::array<std::uint32_t, MaxDepth + 1> path;
+        std::size_t depth = 0;
+        path[0] = 0;
+
+        for(char c : key){
+            std::uint32_t child = findChild(path[depth], c);
+            if(child == npos){
+                return;
+            }
+            path[++depth] = child;
+        }
+
+        std::vector<IMenuItem*>& items = m_nodes[path[depth]].items;
+        auto found = std::find(items.begin(), items.end(), item);
+        if(found == items.end()){
+            return;
+        }
+        *found = items.back();
+        items.pop_back();
+
+        // unlink the nodes no other key passes through any more, from the leaf up
+        for(; depth > 0; --depth){
+            std::uint32_t node = path[depth];
+            if(!m_nodes[node].items.empty() || m_nodes[node].firstChild != npos){
+                break;
+            }
+
+            std::uint32_t* link = &m_nodes[path[depth - 1]].firstChild;
+            while(*link != node){
+                link = &m_nodes[*link].nextSibling;
+            }
+            *link = m_nodes[node].nextSibling;
+
+            std::vector<IMenuItem*>().swap(m_nodes[node].items);
+            m_freeNodes.push_back(node);
+            m_generation++;
+        }
+    }
+
+    void MenuSearchIndex::insertSubtree(IMenuItem* item){
+        insertItem(item);
+
+        // children of lazy pages come and go, they are not indexed
+        if(item->getKind() == ItemKind::Page && !static_cast<MenuPage*>(item)->isLazy()){
+            MenuPage::ReadGuard children(*static_cast<MenuPage*>(item));
+            for(int i = 0; i < children.count(); ++i){
+                insertSubtree(children.at(i));
+            }
+        }
+    }
+
+    void MenuSearchIndex::eraseSubtree(const IMenuItem* item){
+        eraseItem(item);
+
+        if(item->getKind() == ItemKind::Page && !static_cast<const MenuPage*>(item)->isLazy()){
+            MenuPage::ReadGuard children(*static_cast<const MenuPage*>(item));
+            for(int i = 0; i < children.count(); ++i){
+                eraseSubtree(children.at(i));
+            }
+        }
+    }
+
+    void MenuSearchIndex::collect(std::uint32_t start, std::string_view query,
+                                  std::vector<SearchHit>& out, std::size_t maxResults) const{
+        bool verify = trieKey(query).size() < query.size();
+        std::vector<std::uint32_t> stack {start};
+
+        while(!stack.empty() && out.size() < maxResults){
+            std::uint32_t node = stack.back();
+            stack.pop_back();
+
+            for(IMenuItem* item : m_nodes[node].items){
+                // the trie only holds the first word up to MaxDepth characters, the rest is verified
+                if(verify && !matchesWord(m_labels.at(item), query)){
+                    continue;
+                }
+
+                bool seen = std::any_of(out.begin(), out.end(), [item](const SearchHit& hit){
+                    return hit.item == item;
+                });
+                if(!seen){
+                    out.push_back(SearchHit{item, item->getOwner()});
+                    if(out.size() >= maxResults){
+                        return;
+                    }
+                }
+            }
+
+            for(std::uint32_t child = m_nodes[node].firstChild; child != npos; child = m_nodes[child].nextSibling){
+                stack.push_back(child);
+            }
+        }
+    }
+
+    std::vector<SearchHit> MenuSearchIndex::query(std::string_view query, std::size_t maxResults) const{
+        std::vector<SearchHit> hits;
+        this->query(query, hits, maxResults);
+        return hits;
+    }
+
+    void MenuSearchIndex::query(std::string_view query, std::vector<SearchHit>& out, std::size_t maxResults) const{
+        out.clear();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        std::string lowered = toLower(query);
+
+        // every key starts with a word character
+        if(!lowered.empty() && !isWordChar(lowered[0])){
+            return;
+        }
+
+        std::uint32_t node = walk(0, trieKey(lowered));
+        if(node != npos){
+            collect(node, lowered, out, maxResults);
+        }
+    }
+
+    std::vector<MenuPage*> MenuSearchIndex::getPagePath(const IMenuItem* item) const{
+        std::vector<MenuPage*> path;
+        for(MenuPage* page = item->getOwner(); page != nullptr; page = page->getOwner()){
+            path.push_back(page);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    std::size_t MenuSearchIndex::getCount() const{
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_labels.size();
+    }
+
+    void MenuSearchIndex::onItemAdded(MenuPage* page, IMenuItem* item){
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        insertSubtree(item);
+    }
+
+    void MenuSearchIndex::onItemRemoved(MenuPage* page, IMenuItem* item){
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        eraseSubtree(item);
+    }
+
+    void MenuSearchIndex::onLabelChanged(IMenuItem* item){
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        // status suffixes change the displayed label only, the indexed base label stays
+        auto it = m_labels.find(item);
+        if(it != m_labels.end() && it->second != toLower(item->getBaseLabel())){
+            eraseItem(item);
+            insertItem(item);
+        }
+    }
+
+    MenuSearchIndex::TypeAhead::TypeAhead(const MenuSearchIndex& index) : m_index(&index), m_generation(index.m_generation){}
+
+    void MenuSearchIndex::TypeAhead::revalidate() const{
+        if(m_generation == m_index->m_generation){
+            return;
+        }
+        m_generation = m_index->m_generation;
+
+        // same positions push() would have found on the current trie
+        std::size_t keyLength = trieKey(m_text).size();
+        std::uint32_t node = m_text.empty() || isWordChar(m_text[0]) ? 0 : npos;
+
+        m_nodes.clear();
+        for(std::size_t i = 0; i < m_text.size(); ++i){
+            if(i < keyLength && node != npos){
+                node = m_index->findChild(node, m_text[i]);
+            }
+            m_nodes.push_back(node);
+        }
+    }
+
+    void MenuSearchIndex::TypeAhead::push(char c){
+        std::shared_lock<std::shared_mutex> lock(m_index->m_mutex);
+        revalidate();
+
+        c = lower(c);
+        m_text += c;
+
+        std::uint32_t parent = m_nodes.empty() ? 0 : m_nodes.back();
+
+        // past the first word or MaxDepth the trie position no longer changes
+        if(trieKey(m_text).size() < m_text.size()){
+            // a query cannot start outside a word
+            m_nodes.push_back(m_text.size() == 1 ? npos : parent);
+            return;
+        }
+        if(parent == npos){
+            m_nodes.push_back(parent);
+            return;
+        }
+        m_nodes.push_back(m_index->findChild(parent, c));
+    }
+
+    void MenuSearchIndex::TypeAhead::pop(){
+        std::shared_lock<std::shared_mutex> lock(m_index->m_mutex);
+        revalidate();
+        if(!m_text.empty()){
+            m_text.pop_back();
+            m_nodes.pop_back();
+        }
+    }
+
+    void MenuSearchIndex::TypeAhead::clear(){
+        m_text.clear();
+        m_nodes.clear();
+    }
+
+    std::string_view MenuSearchIndex::TypeAhead::getText() const{
+        return m_text;
+    }
+
+    void MenuSearchIndex::TypeAhead::results(std::vector<SearchHit>& out, std::size_t maxResults) const{
+        out.clear();
+        std::shared_lock<std::shared_mutex> lock(m_index->m_mutex);
+
+        // freed nodes may have been reused for other keys
+        revalidate();
+
+        std::uint32_t node = m_nodes.empty() ? 0 : m_nodes.back();
+
+        // the prefix may have been added to the index after it was typed
+        if(node == npos && !m_text.empty() && isWordChar(m_text[0])){
+            node = m_index->walk(0, trieKey(m_text));
+        }
+        if(node != npos){
+            m_index->collect(node, m_text, out, maxResults);
+        }
+    }
+
+}
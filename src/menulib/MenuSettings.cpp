@@ -0,0 +1,411 @@
+#include "menulib/MenuSettings.hpp"
+#include "menulib/IMenuSlider.hpp"
+#include "menulib/MenuToggle.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mr{
+
+    namespace{
+        constexpr std::string_view Header = "MENULIB-SETTINGS 1\n";
+
+        bool isStateful(const IMenuItem* item){
+            return item->getKind() == ItemKind::Toggle || item->getKind() == ItemKind::Slider;
+        }
+
+        /**
+        * @brief FNV-1a checksum of a journal line.
+        */
+        std::uint32_t checksum(std::string_view text){
+            std::uint32_t hash = 2166136261u;
+            for(unsigned char c : text){
+                hash ^= c;
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        /**
+        * @brief Appends "checksum<TAB>key<TAB>value<LF>", tabs and line breaks in keys escaped.
+        */
+        void appendRecord(std::string& out, std::string_view key, std::string_view value){
+            std::string payload;
+            payload.reserve(key.size() + value.size() + 1);
+            for(char c : key){
+                switch(c){
+                    case '\\': payload += "\\\\"; break;
+                    case '\t': payload += "\\t"; break;
+                    case '\n': payload += "\\n"; break;
+                    default: payload += c;
+                }
+            }
+            payload += '\t';
+            payload.append(value.data(), value.size());
+
+            char hex[9];
+            std::snprintf(hex, sizeof(hex), "%08x", static_cast<unsigned>(checksum(payload)));
+            out.append(hex, 8);
+            out += '\t';
+            out += payload;
+            out += '\n';
+        }
+
+        /**
+        * @brief Parses one journal line, false if it is damaged.
+        */
+        bool parseRecord(std::string_view line, std::string& key, std::string& value){
+            if(line.size() < 10 || line[8] != '\t'){
+                return false;
+            }
+
+            std::uint32_t expected = 0;
+            std::from_chars_result result = std::from_chars(line.data(), line.data() + 8, expected, 16);
+            std::string_view payload = line.substr(9);
+            if(result.ptr != line.data() + 8 || checksum(payload) != expected){
+                return false;
+            }
+
+            std::size_t tab = payload.find('\t');
+            if(tab == std::string_view::npos){
+                return false;
+            }
+
+            key.clear();
+            for(std::size_t i = 0; i < tab; ++i){
+                char c = payload[i];
+                if(c == '\\' && i + 1 < tab){
+                    c = payload[++i];
+                    c = c == 't' ? '\t' : c == 'n' ? '\n' : c;
+                }
+                key += c;
+            }
+            value.assign(payload.substr(tab + 1));
+            return true;
+        }
+
+        void syncFile(std::FILE* file){
+#ifdef _WIN32
+            _commit(_fileno(file));
+#else
+            ::fsync(::fileno(file));
+#endif
+        }
+
+        /**
+        * @brief Writes data to a file and waits until it reached the disk.
+        */
+        void writeDurably(const std::string& path, const std::string& data, const char* mode){
+            std::FILE* file = std::fopen(path.c_str(), mode);
+            if(file == nullptr){
+                throw std::runtime_error("MenuSettings: Cannot open " + path);
+            }
+
+            bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size()
+                        && std::fflush(file) == 0;
+            if(written){
+                syncFile(file);
+            }
+            if(std::fclose(file) != 0 || !written){
+                throw std::runtime_error("MenuSettings: Cannot write " + path);
+            }
+        }
+
+        /**
+        * @brief Makes a rename in a directory durable.
+        */
+        void syncDirectory(const std::filesystem::path& file){
+#ifndef _WIN32
+            std::filesystem::path directory = file.parent_path();
+            int handle = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+            if(handle >= 0){
+                ::fsync(handle);
+                ::close(handle);
+            }
+#endif
+        }
+    }
+
+    MenuSettings::MenuSettings(MenuPage* root, std::string path, std::size_t compactThreshold)
+        : m_root(root), m_path(std::move(path)), m_compactThreshold(compactThreshold), m_paths(root){
+        if(root == nullptr){
+            throw std::invalid_argument("MenuSettings: Root cannot be nullptr");
+        }
+
+        // no change may slip in between indexing and attaching
+        MenuPage::ObserverLock observers;
+        m_paths.build(*this);
+        root->addObserver(this);
+    }
+
+    MenuSettings::~MenuSettings(){
+        m_root->removeObserver(this);
+    }
+
+    void MenuSettings::pathAdded(const MenuPaths::Node& node, bool renamed){
+        if(!isStateful(node.item)){
+            return;
+        }
+        m_items[node.path] = node.item;
+
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        if(renamed){
+            // the value stays with the item, the next save stores it under the new key
+            m_dirty.insert(node.item);
+            return;
+        }
+
+        // an item added after load() still gets its saved value
+        auto saved = m_saved.find(node.path);
+        if(saved != m_saved.end() && apply(node.item, saved->second)){
+            m_dirty.erase(node.item);
+        }
+    }
+
+    void MenuSettings::pathRemoved(const MenuPaths::Node& node, bool renamed){
+        if(!isStateful(node.item)){
+            return;
+        }
+
+        auto owned = m_items.find(node.path);
+        if(owned != m_items.end() && owned->second == node.item){
+            m_items.erase(owned);
+        }
+        if(!renamed){
+            std::lock_guard<std::mutex> lock(m_dirtyMutex);
+            m_dirty.erase(node.item);
+        }
+    }
+
+    std::string MenuSettings::valueOf(const IMenuItem* item){
+        if(item->getKind() == ItemKind::Toggle){
+            return static_cast<const MenuToggle*>(item)->getState() ? "1" : "0";
+        }
+
+        char buffer[32];
+        double value = static_cast<const IMenuSlider*>(item)->getNumericValue();
+        std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    }
+
+    bool MenuSettings::apply(IMenuItem* item, std::string_view value){
+        if(item->getKind() == ItemKind::Toggle){
+            if(value != "0" && value != "1"){
+                return false;
+            }
+            static_cast<MenuToggle*>(item)->setState(value == "1");
+            return true;
+        }
+
+        double number = 0;
+        std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(), number);
+        // from_chars also takes "nan" and "inf", which no slider can hold
+        if(result.ec != std::errc() || result.ptr != value.data() + value.size() || !std::isfinite(number)){
+            return false;
+        }
+        static_cast<IMenuSlider*>(item)->setNumericValue(number);
+        return true;
+    }
+
+    bool MenuSettings::readJournal(){
+        m_read = true;
+
+        std::ifstream input(m_path, std::ios::binary);
+        if(!input){
+            return false;
+        }
+        std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        input.close();
+
+        // a crash while the first save wrote the header leaves a piece of it
+        if(content.size() < Header.size() && Header.substr(0, content.size()) == content){
+            std::filesystem::resize_file(m_path, 0);
+            return false;
+        }
+        if(content.compare(0, Header.size(), Header) != 0){
+            throw std::runtime_error("MenuSettings: Not a settings journal " + m_path);
+        }
+
+        std::size_t offset = Header.size();
+        std::size_t records = 0;
+        std::string key;
+        std::string value;
+
+        while(offset < content.size()){
+            std::size_t end = content.find('\n', offset);
+            if(end == std::string::npos
+               || !parseRecord(std::string_view(content).substr(offset, end - offset), key, value)){
+                // everything from a torn or damaged line on is dropped
+                std::filesystem::resize_file(m_path, offset);
+                break;
+            }
+            m_saved[key] = value;
+            records++;
+            offset = end + 1;
+        }
+        m_journalRecords = records;
+        return true;
+    }
+
+    std::size_t MenuSettings::load(){
+        // the tree may change on other threads, tracked items stay alive while notifications are held off
+        MenuPage::ObserverLock observers;
+
+        if(!readJournal()){
+            return 0;
+        }
+
+        std::size_t applied = 0;
+        for(const auto& [savedKey, savedValue] : m_saved){
+            auto item = m_items.find(savedKey);
+            if(item != m_items.end() && apply(item->second, savedValue)){
+                std::lock_guard<std::mutex> lock(m_dirtyMutex);
+                m_dirty.erase(item->second);
+                applied++;
+            }
+        }
+        return applied;
+    }
+
+    std::size_t MenuSettings::save(){
+        MenuPage::ObserverLock observers;
+
+        // values already in the journal are known before any write, compaction would drop them otherwise
+        if(!m_read){
+            readJournal();
+        }
+
+        std::unordered_set<const IMenuItem*> dirty;
+        {
+            std::lock_guard<std::mutex> lock(m_dirtyMutex);
+            dirty.swap(m_dirty);
+        }
+
+        std::string out;
+        std::vector<std::pair<const std::string*, std::string>> written;
+
+        for(const IMenuItem* item : dirty){
+            const MenuPaths::Node* node = m_paths.find(item);
+            if(node == nullptr || !isStateful(item)){
+                continue;
+            }
+
+            std::string value = valueOf(item);
+            auto saved = m_saved.find(node->path);
+            if(saved != m_saved.end() && saved->second == value){
+                continue;
+            }
+            appendRecord(out, node->path, value);
+            written.emplace_back(&node->path, std::move(value));
+        }
+
+        if(written.empty()){
+            return 0;
+        }
+
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(m_path, error);
+        if(error){
+            size = 0;
+        }
+        try{
+            writeDurably(m_path, size == 0 ? std::string(Header) + out : out, "ab");
+        }
+        catch(...){
+            // a short write or failed sync may leave part of a record, cut it off so later saves are not appended to it
+            std::filesystem::resize_file(m_path, size, error);
+            if(error){
+                // the next save reads the journal again, which drops the damaged tail
+                m_read = false;
+            }
+
+            // the items stay dirty
+            std::lock_guard<std::mutex> lock(m_dirtyMutex);
+            m_dirty.insert(dirty.begin(), dirty.end());
+            throw;
+        }
+
+        for(auto& [key, value] : written){
+            m_saved[*key] = std::move(value);
+        }
+        m_journalRecords += written.size();
+
+        if(m_journalRecords > m_saved.size() + m_compactThreshold){
+            compact();
+        }
+        return written.size();
+    }
+
+    void MenuSettings::compact(){
+        MenuPage::ObserverLock observers;
+
+        if(!m_read){
+            readJournal();
+        }
+
+        std::string out(Header);
+        for(const auto& [key, value] : m_saved){
+            appendRecord(out, key, value);
+        }
+
+        // the journal is replaced in one step, a crash leaves either the old or the new file
+        std::string temporary = m_path + ".tmp";
+        writeDurably(temporary, out, "wb");
+        std::filesystem::rename(temporary, m_path);
+        syncDirectory(m_path);
+
+        m_journalRecords = m_saved.size();
+    }
+
+    std::string MenuSettings::getKey(const IMenuItem* item) const{
+        MenuPage::ObserverLock observers;
+        const MenuPaths::Node* node = m_paths.find(item);
+        return (node == nullptr || !isStateful(item)) ? std::string() : node->path;
+    }
+
+    IMenuItem* MenuSettings::find(std::string_view key) const{
+        MenuPage::ObserverLock observers;
+        auto it = m_items.find(std::string(key));
+        return it == m_items.end() ? nullptr : it->second;
+    }
+
+    std::size_t MenuSettings::getDirtyCount() const{
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        return m_dirty.size();
+    }
+
+    std::size_t MenuSettings::getJournalRecords() const{
+        MenuPage::ObserverLock observers;
+        return m_journalRecords;
+    }
+
+    void MenuSettings::onItemAdded(MenuPage* page, IMenuItem* item){
+        m_paths.add(page, item, *this);
+    }
+
+    void MenuSettings::onItemRemoved(MenuPage* page, IMenuItem* item){
+        m_paths.remove(page, item, *this);
+    }
+
+    void MenuSettings::onLabelChanged(IMenuItem* item){
+        m_paths.relabel(item, *this);
+    }
+
+    void MenuSettings::onValueChanged(IMenuItem* item){
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        m_dirty.insert(item);
+    }
+}
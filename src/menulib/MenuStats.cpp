@@ -0,0 +1,442 @@
+#include "menulib/MenuStats.hpp"
+#include "menulib/IMenuItem.hpp"
+#include "menulib/LabelPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <utility>
+
+/**
+* @brief Distinct items each thread keeps statistics for, further items are counted as dropped.
+*
+* Set it with the MENULIB_INSTRUMENTATION_SLOTS CMake cache variable.
+*/
+#ifndef MENULIB_INSTRUMENTATION_SLOTS
+#define MENULIB_INSTRUMENTATION_SLOTS 128
+#endif
+
+namespace mr{
+
+    struct MenuStats::Counters{
+        /**
+        * @brief Item of the slot, nullptr while free; published last when a slot is claimed.
+        */
+        std::atomic<const IMenuItem*> item {};
+        /**
+        * @brief Identifier of the item, tells it apart from a later item at the same address.
+        */
+        ItemId id {};
+        /**
+        * @brief Interned base label when the slot was claimed, a reference is held while the slot is used.
+        */
+        std::string_view label {};
+        std::atomic<std::uint64_t> count[EventCount] {};
+        std::atomic<std::uint64_t> totalNs[EventCount] {};
+        std::atomic<std::uint64_t> maxNs[EventCount] {};
+        std::atomic<std::uint64_t> buckets[EventCount][BucketCount] {};
+    };
+
+    namespace{
+
+        using Counters = MenuStats::Counters;
+
+        constexpr std::size_t SlotCount = MENULIB_INSTRUMENTATION_SLOTS;
+
+        /**
+        * @brief Slots tried before a record is dropped, so a full table stays cheap.
+        */
+        constexpr std::size_t MaxProbes = SlotCount < 16 ? SlotCount : 16;
+
+        /**
+        * @brief Statistics of one thread, written by that thread only.
+        */
+        struct Table{
+            Counters slots[SlotCount] {};
+            std::atomic<std::uint64_t> dropped {};
+            /**
+            * @brief Reset generation the counters belong to.
+            */
+            std::uint64_t epoch {};
+        };
+
+        /**
+        * @brief Tables of the running threads and the sums of the exited ones.
+        */
+        struct Registry{
+            std::mutex mutex {};
+            std::vector<Table*> tables {};
+            std::map<ItemId, MenuStats::ItemStats> retired {};
+            std::uint64_t retiredDropped {};
+            std::atomic<std::uint64_t> epoch {};
+        };
+
+        /**
+        * @brief Returns the registry, never destroyed so threads may end after main().
+        */
+        Registry& registry(){
+            static Registry* instance = new Registry();
+            return *instance;
+        }
+
+        /**
+        * @brief Adds to a counter only its owner thread writes, no read-modify-write needed.
+        */
+        void bump(std::atomic<std::uint64_t>& counter, std::uint64_t value){
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        std::size_t bucketOf(std::uint64_t ns){
+            std::size_t bucket = 0;
+            while(ns != 0 && bucket < MenuStats::BucketCount - 1){
+                ns >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        /**
+        * @brief Frees every slot of a table. Called with the registry locked.
+        */
+        void clear(Table& table){
+            for(Counters& slot : table.slots){
+                if(slot.item.load(std::memory_order_relaxed) == nullptr){
+                    continue;
+                }
+                slot.item.store(nullptr, std::memory_order_relaxed);
+                LabelPool::shared().release(slot.label);
+                slot.label = {};
+                for(std::size_t e = 0; e < MenuStats::EventCount; ++e){
+                    slot.count[e].store(0, std::memory_order_relaxed);
+                    slot.totalNs[e].store(0, std::memory_order_relaxed);
+                    slot.maxNs[e].store(0, std::memory_order_relaxed);
+                    for(std::atomic<std::uint64_t>& bucket : slot.buckets[e]){
+                        bucket.store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+            table.dropped.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+        * @brief Adds a slot's counters to item statistics. Called with the registry locked.
+        */
+        void accumulate(MenuStats::ItemStats& stats, const Counters& slot){
+            for(std::size_t e = 0; e < MenuStats::EventCount; ++e){
+                MenuStats::EventStats& event = stats.events[e];
+                event.count += slot.count[e].load(std::memory_order_relaxed);
+                event.totalNs += slot.totalNs[e].load(std::memory_order_relaxed);
+                event.maxNs = std::max(event.maxNs, slot.maxNs[e].load(std::memory_order_relaxed));
+                for(std::size_t b = 0; b < MenuStats::BucketCount; ++b){
+                    event.buckets[b] += slot.buckets[e][b].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void accumulate(std::map<ItemId, MenuStats::ItemStats>& items,
+                        std::uint64_t& dropped, const Table& table){
+            for(const Counters& slot : table.slots){
+                const IMenuItem* item = slot.item.load(std::memory_order_acquire);
+                if(item == nullptr){
+                    continue;
+                }
+                MenuStats::ItemStats& stats = items[slot.id];
+                if(stats.item == nullptr){
+                    stats.item = item;
+                    stats.label = std::string(slot.label);
+                }
+                accumulate(stats, slot);
+            }
+            dropped += table.dropped.load(std::memory_order_relaxed);
+        }
+
+        /**
+        * @brief Owns the calling thread's table and hands its sums over when the thread ends.
+        */
+        struct LocalTable{
+            std::unique_ptr<Table> table {};
+
+            Table* get(){
+                if(!table){
+                    std::unique_ptr<Table> created(new (std::nothrow) Table());
+                    if(!created){
+                        return nullptr;
+                    }
+                    Registry& shared = registry();
+                    std::lock_guard<std::mutex> lock(shared.mutex);
+                    created->epoch = shared.epoch.load(std::memory_order_relaxed);
+                    shared.tables.push_back(created.get());
+                    table = std::move(created);
+                }
+                return table.get();
+            }
+
+            ~LocalTable(){
+                if(!table){
+                    return;
+                }
+                Registry& shared = registry();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                if(table->epoch == shared.epoch.load(std::memory_order_relaxed)){
+                    accumulate(shared.retired, shared.retiredDropped, *table);
+                }
+                shared.tables.erase(std::find(shared.tables.begin(), shared.tables.end(), table.get()));
+                clear(*table);
+            }
+        };
+
+        thread_local LocalTable t_table;
+
+        /**
+        * @brief Appends a string as a JSON string literal.
+        */
+        void appendJsonString(std::string& out, std::string_view text){
+            out += '"';
+            for(char c : text){
+                switch(c){
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if(static_cast<unsigned char>(c) < 0x20){
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                            out += escaped;
+                        }
+                        else{
+                            out += c;
+                        }
+                }
+            }
+            out += '"';
+        }
+
+        template <typename... Args>
+        void appendFormat(std::string& out, const char* format, Args... args){
+            char buffer[256];
+            int length = std::snprintf(buffer, sizeof(buffer), format, args...);
+            if(length > 0){
+                out.append(buffer, std::min(static_cast<std::size_t>(length), sizeof(buffer) - 1));
+            }
+        }
+    }
+
+    MenuStats::Counters* MenuStats::counters(const IMenuItem* item) noexcept{
+        if(item == nullptr){
+            return nullptr;
+        }
+
+        Table* table = t_table.get();
+        if(table == nullptr){
+            return nullptr;
+        }
+
+        Registry& shared = registry();
+        if(table->epoch != shared.epoch.load(std::memory_order_relaxed)){
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            clear(*table);
+            table->epoch = shared.epoch.load(std::memory_order_relaxed);
+        }
+
+        // keyed on the identifier too, so an item reusing the address of a destroyed
+        // one gets a slot of its own while a relabelled item keeps its slot
+        ItemId id = item->getId();
+        std::size_t start = static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(item) >> 4) * 0x9E3779B97F4A7C15ull);
+
+        for(std::size_t probe = 0; probe < MaxProbes; ++probe){
+            Counters& slot = table->slots[(start + probe) % SlotCount];
+            const IMenuItem* stored = slot.item.load(std::memory_order_relaxed);
+
+            if(stored == item && slot.id == id){
+                return &slot;
+            }
+            if(stored == nullptr){
+                try{
+                    slot.label = LabelPool::shared().intern(item->getBaseLabel());
+                }
+                catch(...){
+                    break;
+                }
+                slot.id = id;
+                slot.item.store(item, std::memory_order_release);
+                return &slot;
+            }
+        }
+
+        bump(table->dropped, 1);
+        return nullptr;
+    }
+
+    void MenuStats::add(Counters* counters, Event event, std::uint64_t ns, std::uint64_t count) noexcept{
+        std::size_t e = static_cast<std::size_t>(event);
+        // events timed together each get the average latency
+        std::uint64_t each = ns / count;
+        bump(counters->count[e], count);
+        bump(counters->totalNs[e], ns);
+        if(each > counters->maxNs[e].load(std::memory_order_relaxed)){
+            counters->maxNs[e].store(each, std::memory_order_relaxed);
+        }
+        bump(counters->buckets[e][bucketOf(each)], count);
+    }
+
+    void MenuStats::record(const IMenuItem* item, Event event, std::uint64_t ns, std::uint64_t count) noexcept{
+        if(count == 0){
+            return;
+        }
+        if(Counters* slot = counters(item)){
+            add(slot, event, ns, count);
+        }
+    }
+
+    MenuStats::Snapshot MenuStats::snapshot(){
+        Registry& shared = registry();
+        std::map<ItemId, ItemStats> items;
+        Snapshot result;
+
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            items = shared.retired;
+            result.dropped = shared.retiredDropped;
+
+            std::uint64_t epoch = shared.epoch.load(std::memory_order_relaxed);
+            for(const Table* table : shared.tables){
+                // tables of an earlier generation are cleared by their thread later
+                if(table->epoch == epoch){
+                    accumulate(items, result.dropped, *table);
+                }
+            }
+        }
+
+        result.items.reserve(items.size());
+        for(auto& entry : items){
+            result.items.push_back(std::move(entry.second));
+        }
+        std::stable_sort(result.items.begin(), result.items.end(), [](const ItemStats& a, const ItemStats& b){
+            return a.totalCount() > b.totalCount();
+        });
+        return result;
+    }
+
+    void MenuStats::reset(){
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.retired.clear();
+        shared.retiredDropped = 0;
+        shared.epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const char* MenuStats::eventName(Event event){
+        switch(event){
+            case Event::Select: return "select";
+            case Event::Left: return "left";
+            case Event::Right: return "right";
+            case Event::Back: return "back";
+            case Event::Callback: return "callback";
+        }
+        return "unknown";
+    }
+
+    std::uint64_t MenuStats::EventStats::quantileNs(double quantile) const{
+        if(count == 0){
+            return 0;
+        }
+
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(count)));
+        rank = std::min(std::max<std::uint64_t>(rank, 1), count);
+
+        std::uint64_t seen = 0;
+        for(std::size_t b = 0; b < BucketCount; ++b){
+            seen += buckets[b];
+            if(seen >= rank){
+                std::uint64_t upper = b == 0 ? 0 : (std::uint64_t{1} << b) - 1;
+                return std::min(upper, maxNs);
+            }
+        }
+        return maxNs;
+    }
+
+    std::uint64_t MenuStats::ItemStats::totalCount() const{
+        std::uint64_t total = 0;
+        for(const EventStats& event : events){
+            total += event.count;
+        }
+        return total;
+    }
+
+    std::string MenuStats::Snapshot::toText() const{
+        std::string out;
+        appendFormat(out, "%-32s %-8s %10s %10s %10s %10s %10s\n",
+                     "item", "event", "count", "mean us", "p50 us", "p99 us", "max us");
+
+        for(const ItemStats& item : items){
+            for(std::size_t e = 0; e < EventCount; ++e){
+                const EventStats& event = item.events[e];
+                if(event.count == 0){
+                    continue;
+                }
+                appendFormat(out, "%-32.32s %-8s %10llu %10.3f %10.3f %10.3f %10.3f\n",
+                             item.label.c_str(), eventName(static_cast<Event>(e)),
+                             static_cast<unsigned long long>(event.count),
+                             static_cast<double>(event.totalNs) / static_cast<double>(event.count) / 1000.0,
+                             static_cast<double>(event.quantileNs(0.5)) / 1000.0,
+                             static_cast<double>(event.quantileNs(0.99)) / 1000.0,
+                             static_cast<double>(event.maxNs) / 1000.0);
+            }
+        }
+
+        if(dropped != 0){
+            appendFormat(out, "dropped: %llu\n", static_cast<unsigned long long>(dropped));
+        }
+        return out;
+    }
+
+    std::string MenuStats::Snapshot::toJson() const{
+        std::string out;
+        appendFormat(out, "{\"dropped\": %llu, \"items\": [", static_cast<unsigned long long>(dropped));
+
+        for(std::size_t i = 0; i < items.size(); ++i){
+            const ItemStats& item = items[i];
+            out += i == 0 ? "\n  {\"label\": " : ",\n  {\"label\": ";
+            appendJsonString(out, item.label);
+            out += ", \"events\": {";
+
+            bool first = true;
+            for(std::size_t e = 0; e < EventCount; ++e){
+                const EventStats& event = item.events[e];
+                if(event.count == 0){
+                    continue;
+                }
+                appendFormat(out, "%s\"%s\": {\"count\": %llu, \"total_ns\": %llu, \"max_ns\": %llu, "
+                                  "\"p50_ns\": %llu, \"p99_ns\": %llu, \"buckets\": [",
+                             first ? "" : ", ", eventName(static_cast<Event>(e)),
+                             static_cast<unsigned long long>(event.count),
+                             static_cast<unsigned long long>(event.totalNs),
+                             static_cast<unsigned long long>(event.maxNs),
+                             static_cast<unsigned long long>(event.quantileNs(0.5)),
+                             static_cast<unsigned long long>(event.quantileNs(0.99)));
+                first = false;
+
+                // trailing empty buckets are left out
+                std::size_t used = BucketCount;
+                while(used > 0 && event.buckets[used - 1] == 0){
+                    --used;
+                }
+                for(std::size_t b = 0; b < used; ++b){
+                    appendFormat(out, b == 0 ? "%llu" : ", %llu", static_cast<unsigned long long>(event.buckets[b]));
+                }
+                out += "]}";
+            }
+            out += "}}";
+        }
+
+        out += items.empty() ? "]}\n" : "\n]}\n";
+        return out;
+    }
+}
@@ -0,0 +1,524 @@
+#include "menulib/MenuTextParser.hpp"
+#include "menulib/MenuOption.hpp"
+#include "menulib/MenuSlider.hpp"
+#include "menulib/MenuToggle.hpp"
+#include <charconv>
+#include <climits>
+#include <cfloat>
+#include <cmath>
+#include <string_view>
+#include <vector>
+
+namespace mr{
+
+    MenuParseError::MenuParseError(std::size_t line, std::size_t column, const std::string& message)
+        : std::runtime_error("MenuTextParser: line " + std::to_string(line) + ", column "
+                             + std::to_string(column) + ": " + message),
+          m_line(line), m_column(column) {}
+
+    std::size_t MenuParseError::getLine() const{
+        return m_line;
+    }
+
+    std::size_t MenuParseError::getColumn() const{
+        return m_column;
+    }
+
+    namespace{
+
+        struct Position{
+            std::size_t line;
+            std::size_t column;
+        };
+
+        [[noreturn]] void fail(Position at, const std::string& message){
+            throw MenuParseError(at.line, at.column, message);
+        }
+
+        /**
+        * @brief Character source reading the stream in chunks and tracking the position.
+        */
+        class Reader{
+            private:
+                std::istream& m_input;
+                std::vector<char> m_buffer = std::vector<char>(64 * 1024);
+                std::size_t m_pos {};
+                std::size_t m_end {};
+                Position m_at {1, 1};
+
+                bool refill(){
+                    m_input.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+                    m_pos = 0;
+                    m_end = static_cast<std::size_t>(m_input.gcount());
+                    return m_end != 0;
+                }
+
+            public:
+                static constexpr int End = -1;
+
+                explicit Reader(std::istream& input) : m_input(input) {}
+
+                Position position() const{
+                    return m_at;
+                }
+
+                int peek(){
+                    if(m_pos == m_end && !refill()){
+                        return End;
+                    }
+                    return static_cast<unsigned char>(m_buffer[m_pos]);
+                }
+
+                int get(){
+                    int c = peek();
+                    if(c == End){
+                        return End;
+                    }
+                    m_pos++;
+                    if(c == '\n'){
+                        m_at.line++;
+                        m_at.column = 1;
+                    }
+                    else{
+                        m_at.column++;
+                    }
+                    return c;
+                }
+
+                void skipSpace(){
+                    for(int c = peek(); c == ' ' || c == '\t' || c == '\n' || c == '\r'; c = peek()){
+                        get();
+                    }
+                }
+
+                void expect(char expected, const char* message){
+                    skipSpace();
+                    if(peek() != static_cast<unsigned char>(expected)){
+                        fail(m_at, message);
+                    }
+                    get();
+                }
+
+                /**
+                * @brief Reads a string literal, the reader must stand on its opening quote.
+                */
+                void readString(std::string& out){
+                    out.clear();
+                    if(peek() != '"'){
+                        fail(m_at, "expected a string");
+                    }
+                    get();
+
+                    for(;;){
+                        // copy the plain run in one go, it is most of the string
+                        std::size_t start = m_pos;
+                        while(m_pos < m_end){
+                            char c = m_buffer[m_pos];
+                            if(c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20){
+                                break;
+                            }
+                            m_pos++;
+                        }
+                        out.append(m_buffer.data() + start, m_pos - start);
+                        m_at.column += m_pos - start;
+
+                        Position at = m_at;
+                        int c = get();
+                        if(c == End){
+                            fail(at, "unterminated string");
+                        }
+                        if(c == '"'){
+                            return;
+                        }
+                        if(c == '\\'){
+                            readEscape(out, at);
+                        }
+                        else if(c < 0x20){
+                            fail(at, "control character in string");
+                        }
+                        else{
+                            out += static_cast<char>(c);
+                        }
+                    }
+                }
+
+                double readNumber(){
+                    Position at = m_at;
+                    char digits[64];
+                    std::size_t length = 0;
+
+                    for(int c = peek(); (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'; c = peek()){
+                        if(length == sizeof(digits)){
+                            fail(at, "number is too long");
+                        }
+                        digits[length++] = static_cast<char>(get());
+                    }
+
+                    double value = 0;
+                    std::from_chars_result result = std::from_chars(digits, digits + length, value);
+                    if(length == 0 || result.ec != std::errc() || result.ptr != digits + length){
+                        fail(at, "invalid number");
+                    }
+                    return value;
+                }
+
+                bool readBool(){
+                    Position at = m_at;
+                    char word[6];
+                    std::size_t length = 0;
+
+                    for(int c = peek(); c >= 'a' && c <= 'z' && length < sizeof(word); c = peek()){
+                        word[length++] = static_cast<char>(get());
+                    }
+
+                    std::string_view text(word, length);
+                    if(text == "true"){
+                        return true;
+                    }
+                    if(text == "false"){
+                        return false;
+                    }
+                    fail(at, "expected true or false");
+                }
+
+            private:
+                int readHex(Position at){
+                    int value = 0;
+                    for(int i = 0; i < 4; ++i){
+                        int c = get();
+                        int digit = (c >= '0' && c <= '9') ? c - '0'
+                                  : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                                  : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+                        if(digit < 0){
+                            fail(at, "invalid \\u escape");
+                        }
+                        value = value * 16 + digit;
+                    }
+                    return value;
+                }
+
+                void readEscape(std::string& out, Position at){
+                    int c = get();
+                    switch(c){
+                        case '"': out += '"'; return;
+                        case '\\': out += '\\'; return;
+                        case '/': out += '/'; return;
+                        case 'b': out += '\b'; return;
+                        case 'f': out += '\f'; return;
+                        case 'n': out += '\n'; return;
+                        case 'r': out += '\r'; return;
+                        case 't': out += '\t'; return;
+                        case 'u': break;
+                        default: fail(at, "invalid escape");
+                    }
+
+                    std::uint32_t code = static_cast<std::uint32_t>(readHex(at));
+                    if(code >= 0xD800 && code <= 0xDBFF){
+                        if(get() != '\\' || get() != 'u'){
+                            fail(at, "unpaired surrogate");
+                        }
+                        std::uint32_t low = static_cast<std::uint32_t>(readHex(at));
+                        if(low < 0xDC00 || low > 0xDFFF){
+                            fail(at, "unpaired surrogate");
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    else if(code >= 0xDC00 && code <= 0xDFFF){
+                        fail(at, "unpaired surrogate");
+                    }
+
+                    if(code < 0x80){
+                        out += static_cast<char>(code);
+                    }
+                    else if(code < 0x800){
+                        out += static_cast<char>(0xC0 | (code >> 6));
+                        out += static_cast<char>(0x80 | (code & 0x3F));
+                    }
+                    else if(code < 0x10000){
+                        out += static_cast<char>(0xE0 | (code >> 12));
+                        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                        out += static_cast<char>(0x80 | (code & 0x3F));
+                    }
+                    else{
+                        out += static_cast<char>(0xF0 | (code >> 18));
+                        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                        out += static_cast<char>(0x80 | (code & 0x3F));
+                    }
+                }
+        };
+
+        /**
+        * @brief Keys seen in one item object.
+        */
+        enum Field : unsigned{
+            FieldType = 1u << 0,
+            FieldLabel = 1u << 1,
+            FieldAction = 1u << 2,
+            FieldItems = 1u << 3,
+            FieldState = 1u << 4,
+            FieldValue = 1u << 5,
+            FieldMin = 1u << 6,
+            FieldMax = 1u << 7,
+            FieldStep = 1u << 8,
+            FieldNumeric = 1u << 9
+        };
+
+        constexpr unsigned SliderFields = FieldValue | FieldMin | FieldMax | FieldStep | FieldNumeric;
+
+        /**
+        * @brief Contents of one item object, collected until it closes.
+        */
+        struct ItemFields{
+            unsigned seen {};
+            std::string type {};
+            std::string label {};
+            std::string action {};
+            std::string numeric {};
+            Position actionAt {};
+            bool state {};
+            double value {};
+            double min {};
+            double max {};
+            double step {1};
+            std::vector<std::unique_ptr<IMenuItem>> children {};
+        };
+
+        Field fieldOf(std::string_view key){
+            if(key == "type") return FieldType;
+            if(key == "label") return FieldLabel;
+            if(key == "action") return FieldAction;
+            if(key == "items") return FieldItems;
+            if(key == "state") return FieldState;
+            if(key == "value") return FieldValue;
+            if(key == "min") return FieldMin;
+            if(key == "max") return FieldMax;
+            if(key == "step") return FieldStep;
+            if(key == "numeric") return FieldNumeric;
+            return static_cast<Field>(0);
+        }
+
+        bool isWhole(double value){
+            return value >= INT_MIN && value <= INT_MAX && std::floor(value) == value;
+        }
+
+        bool fitsFloat(double value){
+            return value >= -FLT_MAX && value <= FLT_MAX;
+        }
+
+        /**
+        * @brief Recursive descent over the item objects.
+        */
+        class Builder{
+            private:
+                Reader& m_in;
+                const MenuActionRegistry* m_registry;
+                std::size_t m_maxDepth;
+                std::string m_key {};
+
+                template <typename F>
+                const F* bind(const ItemFields& fields, const F* (MenuActionRegistry::*find)(std::string_view) const){
+                    if(!(fields.seen & FieldAction) || m_registry == nullptr){
+                        return nullptr;
+                    }
+                    const F* function = (m_registry->*find)(fields.action);
+                    if(function == nullptr){
+                        fail(fields.actionAt, "unknown action \"" + fields.action + "\"");
+                    }
+                    return function;
+                }
+
+                template <typename T>
+                std::unique_ptr<IMenuItem> makeSlider(const ItemFields& fields){
+                    const std::function<void(double)>* function = bind(fields, &MenuActionRegistry::findSlider);
+                    MenuCallback<void(T)> callback = [](T){};
+                    if(function){
+                        // the registry outlives the items, a pointer fits the inline storage on any platform
+                        callback = [function](T value){ (*function)(static_cast<double>(value)); };
+                    }
+                    double value = (fields.seen & FieldValue) ? fields.value : fields.min;
+                    return std::make_unique<MenuSlider<T>>(fields.label, static_cast<T>(value), static_cast<T>(fields.min),
+                                                           static_cast<T>(fields.max), static_cast<T>(fields.step), std::move(callback));
+                }
+
+                void readItems(ItemFields& fields, std::size_t depth){
+                    if(depth > m_maxDepth){
+                        fail(m_in.position(), "pages nested too deep");
+                    }
+
+                    m_in.expect('[', "expected '['");
+                    m_in.skipSpace();
+                    if(m_in.peek() == ']'){
+                        m_in.get();
+                        return;
+                    }
+
+                    for(;;){
+                        fields.children.push_back(readItem(depth, false));
+                        m_in.skipSpace();
+                        Position at = m_in.position();
+                        int c = m_in.get();
+                        if(c == ']'){
+                            return;
+                        }
+                        if(c != ','){
+                            fail(at, "expected ',' or ']'");
+                        }
+                    }
+                }
+
+                std::unique_ptr<IMenuItem> build(ItemFields& fields, Position at, bool root){
+                    if(!(fields.seen & FieldType)){
+                        if(!root){
+                            fail(at, "missing \"type\"");
+                        }
+                        fields.type = "page";
+                    }
+                    if(!(fields.seen & FieldLabel)){
+                        fail(at, "missing \"label\"");
+                    }
+
+                    unsigned allowed = FieldType | FieldLabel;
+                    if(fields.type == "page") allowed |= FieldItems;
+                    else if(fields.type == "option") allowed |= FieldAction;
+                    else if(fields.type == "toggle") allowed |= FieldAction | FieldState;
+                    else if(fields.type == "slider") allowed |= FieldAction | SliderFields;
+                    else fail(at, "unknown type \"" + fields.type + "\"");
+
+                    if(root && fields.type != "page"){
+                        fail(at, "root must be a page");
+                    }
+                    if(fields.seen & ~allowed){
+                        fail(at, "key not allowed for type \"" + fields.type + "\"");
+                    }
+
+                    // item constructors validate ranges and labels, their messages are reported here
+                    try{
+                        if(fields.type == "page"){
+                            auto page = std::make_unique<MenuPage>(fields.label);
+                            for(std::unique_ptr<IMenuItem>& child : fields.children){
+                                page->addItem(child.get());
+                                child.release();
+                            }
+                            return page;
+                        }
+                        if(fields.type == "option"){
+                            const std::function<void()>* function = bind(fields, &MenuActionRegistry::findAction);
+                            return function ? std::make_unique<MenuOption>(fields.label, [function](){ (*function)(); })
+                                            : std::make_unique<MenuOption>(fields.label);
+                        }
+                        if(fields.type == "toggle"){
+                            const std::function<void(bool)>* function = bind(fields, &MenuActionRegistry::findToggle);
+                            return function ? std::make_unique<MenuToggle>(fields.label, fields.state,
+                                                                           [function](bool state){ (*function)(state); })
+                                            : std::make_unique<MenuToggle>(fields.label, fields.state);
+                        }
+
+                        if(!(fields.seen & FieldMin) || !(fields.seen & FieldMax)){
+                            fail(at, "slider needs \"min\" and \"max\"");
+                        }
+                        if(!(fields.seen & FieldNumeric) || fields.numeric == "int"){
+                            if(!isWhole(fields.min) || !isWhole(fields.max) || !isWhole(fields.step)
+                               || ((fields.seen & FieldValue) && !isWhole(fields.value))){
+                                fail(at, "int slider needs whole numbers");
+                            }
+                            return makeSlider<int>(fields);
+                        }
+                        if(fields.numeric == "float"){
+                            // converting a double beyond the float range is undefined
+                            if(!fitsFloat(fields.min) || !fitsFloat(fields.max) || !fitsFloat(fields.step)
+                               || ((fields.seen & FieldValue) && !fitsFloat(fields.value))){
+                                fail(at, "float slider value out of range");
+                            }
+                            return makeSlider<float>(fields);
+                        }
+                        if(fields.numeric == "double"){
+                            return makeSlider<double>(fields);
+                        }
+                        fail(at, "unknown numeric \"" + fields.numeric + "\"");
+                    }
+                    catch(const std::invalid_argument& error){
+                        fail(at, error.what());
+                    }
+                }
+
+            public:
+                Builder(Reader& in, const MenuActionRegistry* registry, std::size_t maxDepth)
+                    : m_in(in), m_registry(registry), m_maxDepth(maxDepth) {}
+
+                std::unique_ptr<IMenuItem> readItem(std::size_t depth, bool root){
+                    m_in.skipSpace();
+                    Position at = m_in.position();
+                    m_in.expect('{', "expected '{'");
+
+                    ItemFields fields;
+                    m_in.skipSpace();
+                    if(m_in.peek() == '}'){
+                        m_in.get();
+                        return build(fields, at, root);
+                    }
+
+                    for(;;){
+                        m_in.skipSpace();
+                        Position keyAt = m_in.position();
+                        m_in.readString(m_key);
+
+                        Field field = fieldOf(m_key);
+                        if(field == 0){
+                            fail(keyAt, "unknown key \"" + m_key + "\"");
+                        }
+                        if(fields.seen & field){
+                            fail(keyAt, "duplicate key \"" + m_key + "\"");
+                        }
+                        fields.seen |= field;
+
+                        m_in.expect(':', "expected ':'");
+                        m_in.skipSpace();
+
+                        switch(field){
+                            case FieldType: m_in.readString(fields.type); break;
+                            case FieldLabel: m_in.readString(fields.label); break;
+                            case FieldAction:
+                                fields.actionAt = m_in.position();
+                                m_in.readString(fields.action);
+                                break;
+                            case FieldNumeric: m_in.readString(fields.numeric); break;
+                            case FieldItems: readItems(fields, depth + 1); break;
+                            case FieldState: fields.state = m_in.readBool(); break;
+                            case FieldValue: fields.value = m_in.readNumber(); break;
+                            case FieldMin: fields.min = m_in.readNumber(); break;
+                            case FieldMax: fields.max = m_in.readNumber(); break;
+                            case FieldStep: fields.step = m_in.readNumber(); break;
+                        }
+
+                        m_in.skipSpace();
+                        Position sepAt = m_in.position();
+                        int c = m_in.get();
+                        if(c == '}'){
+                            break;
+                        }
+                        if(c != ','){
+                            fail(sepAt, "expected ',' or '}'");
+                        }
+                    }
+                    return build(fields, at, root);
+                }
+        };
+    }
+
+    MenuTextParser::MenuTextParser(const MenuActionRegistry* registry, std::size_t maxDepth)
+        : m_registry(registry), m_maxDepth(maxDepth) {}
+
+    std::unique_ptr<MenuPage> MenuTextParser::parse(std::istream& input) const{
+        Reader in(input);
+        Builder builder(in, m_registry, m_maxDepth);
+
+        std::unique_ptr<IMenuItem> root = builder.readItem(0, true);
+
+        in.skipSpace();
+        if(in.peek() != Reader::End){
+            fail(in.position(), "unexpected content after the menu");
+        }
+        return std::unique_ptr<MenuPage>(static_cast<MenuPage*>(root.release()));
+    }
+}
@@ -0,0 +1,74 @@
+#include "menulib/MenuThreadPool.hpp"
+#include <stdexcept>
+
+namespace mr{
+
+    MenuThreadPool::MenuThreadPool(std::size_t threads){
+        if(threads == 0){
+            throw std::invalid_argument("MenuThreadPool: Thread count must be positive");
+        }
+
+        m_workers.reserve(threads);
+        try{
+            for(std::size_t i = 0; i < threads; ++i){
+                m_workers.emplace_back(&MenuThreadPool::work, this);
+            }
+        }
+        catch(...){
+            // destroying a joinable thread terminates, the started workers are joined first
+            stop();
+            throw;
+        }
+    }
+
+    MenuThreadPool::~MenuThreadPool(){
+        stop();
+    }
+
+    void MenuThreadPool::stop(){
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+
+        for(std::thread& worker : m_workers){
+            worker.join();
+        }
+    }
+
+    void MenuThreadPool::work(){
+        for(;;){
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this]{ return m_stopping || !m_tasks.empty(); });
+
+                // queued tasks are still run after stop was requested
+                if(m_tasks.empty()){
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    void MenuThreadPool::submit(std::function<void()> task){
+        if(!task){
+            throw std::invalid_argument("MenuThreadPool: Task cannot be null");
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_wake.notify_one();
+    }
+
+    std::size_t MenuThreadPool::getThreadCount() const{
+        return m_workers.size();
+    }
+
+}
@@ -1,42 +1,61 @@
 #include "menulib/MenuToggle.hpp"
+#include "menulib/MenuStats.hpp"
 
 namespace mr{
 
-    MenuToggle::MenuToggle(const std::string& label, bool initialState)
-        : IMenuItem(label), m_state(initialState), m_baseLabel(label), m_func(nullptr)
+    MenuToggle::MenuToggle(std::string_view label, bool initialState, std::pmr::memory_resource* resource)
+        : IMenuItem(label, resource), m_state(initialState), m_func(nullptr)
     {
         if(label.empty()){
             throw std::invalid_argument("MenuToggle: Label cannot be empty");
         }
-        updateLabel();
     }
 
-    MenuToggle::MenuToggle(const std::string& label, bool initialState, const std::function<void(bool)>& func)
-        : IMenuItem(label), m_state(initialState), m_baseLabel(label), m_func(func)
+    MenuToggle::MenuToggle(std::string_view label, bool initialState, MenuCallback<void(bool)> func,
+                           std::pmr::memory_resource* resource)
+        : IMenuItem(label, resource), m_state(initialState), m_func(std::move(func))
     {
         if(label.empty()){
             throw std::invalid_argument("MenuToggle: Label cannot be empty");
         }
-        if(!func){
+        if(!m_func){
             throw std::invalid_argument("MenuToggle: Function cannot be null");
         }
-        updateLabel();
     }
 
-    void MenuToggle::setLabel(const std::string& label){
-        if(!label.empty())
-        {
-            m_baseLabel = label;
+    void MenuToggle::appendLabel(std::string& out) const{
+        std::string_view base = getBaseLabel();
+        out.append(base.data(), base.size());
+        out += (m_state.load() ? " [ON]" : " [OFF]");
+    }
 
-            updateLabel();
-        }
+    std::string_view MenuToggle::getLabel() const{
+        return composeLabel(m_labelCache);
     }
 
     void MenuToggle::onSelect(MenuNavigator* navigator){
-        m_state = !m_state;
-        updateLabel();
+        bool state = m_state.load();
+        while(!m_state.compare_exchange_weak(state, !state)){
+        }
+
+        notifyValueChanged();
         if(m_func){
-            m_func(m_state);
+            MENULIB_INSTRUMENT(this, Callback);
+            m_func(!state);
+        }
+    }
+
+    bool MenuToggle::getState() const {
+        return m_state.load();
+    }
+
+    void MenuToggle::setState(bool state){
+        if(m_state.exchange(state) != state){
+            notifyValueChanged();
+            if(m_func){
+                MENULIB_INSTRUMENT(this, Callback);
+                m_func(state);
+            }
         }
     }
 
@@ -44,4 +63,8 @@ namespace mr{
         return true;
     }
 
+    ItemKind MenuToggle::getKind() const {
+        return ItemKind::Toggle;
+    }
+
 }
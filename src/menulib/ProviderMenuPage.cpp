@@ -0,0 +1,133 @@
+#include "menulib/ProviderMenuPage.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace mr{
+
+    namespace{
+        /**
+        * @brief Cached children the lookup is sized for on construction, it grows past that on demand.
+        */
+        constexpr std::size_t InitialLookup = 64;
+    }
+
+    ProviderMenuPage::ProviderMenuPage(std::string_view title, IMenuProvider* provider, std::size_t capacity,
+                                       MenuPage* parent, std::pmr::memory_resource* resource)
+        : MenuPage(title, parent, resource), m_provider(provider), m_capacity(capacity){
+        if(provider == nullptr){
+            throw std::invalid_argument("ProviderMenuPage: Provider cannot be nullptr");
+        }
+        if(capacity == 0){
+            throw std::invalid_argument("ProviderMenuPage: Capacity must be positive");
+        }
+        // a page keeping every child, like a MenuBinary page, would otherwise allocate for all of them up front
+        m_lookup.reserve(std::min<std::size_t>(capacity, InitialLookup) + 1);
+    }
+
+    ProviderMenuPage::~ProviderMenuPage(){
+        for(const Entry& entry : m_cache){
+            m_evicted.push_back(entry.item);
+        }
+        destroyEvicted();
+    }
+
+    void ProviderMenuPage::destroyEvicted() const{
+        for(IMenuItem* item : m_evicted){
+            if(!item->isArenaAllocated()){
+                delete item;
+            }
+        }
+        m_evicted.clear();
+    }
+
+    const void* ProviderMenuPage::acquireItems() const{
+        // nested guards see the count of the outermost one
+        if(m_pins++ == 0){
+            m_pinnedCount = m_provider->getCount();
+        }
+        return nullptr;
+    }
+
+    void ProviderMenuPage::releaseItems(const void* pin) const{
+        if(--m_pins == 0){
+            destroyEvicted();
+        }
+    }
+
+    int ProviderMenuPage::pinnedCount(const void* pin) const{
+        return m_pinnedCount;
+    }
+
+    IMenuItem* ProviderMenuPage::pinnedItem(const void* pin, int index) const{
+        auto found = m_lookup.find(index);
+        if(found != m_lookup.end()){
+            m_cache.splice(m_cache.begin(), m_cache, found->second);
+            return found->second->item;
+        }
+
+        IMenuItem* item = m_provider->createItem(index);
+        if(item == nullptr){
+            throw std::logic_error("ProviderMenuPage: Provider returned nullptr");
+        }
+        m_createdCount++;
+
+        // building a child is a read from the caller's point of view
+        const_cast<ProviderMenuPage*>(this)->adopt(item);
+
+        m_cache.push_front(Entry{index, item});
+        m_lookup.emplace(index, m_cache.begin());
+
+        // always called under a guard, so dropped children only die when it is released
+        while(m_cache.size() > m_capacity){
+            m_lookup.erase(m_cache.back().index);
+            m_evicted.push_back(m_cache.back().item);
+            m_cache.pop_back();
+        }
+        return item;
+    }
+
+    int ProviderMenuPage::pinnedIndexOf(const void* pin, const IMenuItem* item) const{
+        for(const Entry& entry : m_cache){
+            if(entry.item == item){
+                return entry.index < m_pinnedCount ? entry.index : -1;
+            }
+        }
+        return -1;
+    }
+
+    void ProviderMenuPage::addItem(IMenuItem* item){
+        throw std::logic_error("ProviderMenuPage: Children come from the provider");
+    }
+
+    bool ProviderMenuPage::removeItem(IMenuItem* item){
+        return false;
+    }
+
+    bool ProviderMenuPage::isLazy() const{
+        return true;
+    }
+
+    void ProviderMenuPage::invalidate(){
+        for(const Entry& entry : m_cache){
+            m_evicted.push_back(entry.item);
+        }
+        m_cache.clear();
+        m_lookup.clear();
+
+        if(m_pins == 0){
+            destroyEvicted();
+        }
+    }
+
+    std::size_t ProviderMenuPage::getCapacity() const{
+        return m_capacity;
+    }
+
+    std::size_t ProviderMenuPage::getCachedCount() const{
+        return m_cache.size();
+    }
+
+    std::size_t ProviderMenuPage::getCreatedCount() const{
+        return m_createdCount;
+    }
+}
@@ -0,0 +1,69 @@
+#include "menulib/VariantMenuPage.hpp"
+#include "menulib/MenuNavigator.hpp"
+
+namespace mr{
+
+    VariantMenuPage::VariantMenuPage(std::string_view title, MenuPage* parent, std::pmr::memory_resource* resource)
+        : MenuPage(title, parent, resource), m_slots(resource), m_order(resource), m_free(resource){}
+
+    VariantMenuPage::~VariantMenuPage(){
+        for(Slot& slot : m_slots){
+            IMenuItem** item = std::get_if<IMenuItem*>(&slot);
+            if(item != nullptr && *item != nullptr && !(*item)->isArenaAllocated()){
+                delete *item;
+            }
+        }
+        // inline items go with m_slots, MenuPage must not delete them
+        detachItems();
+    }
+
+    int VariantMenuPage::findSlot(const IMenuItem* item) const{
+        for(std::size_t i = 0; i < m_order.size(); ++i){
+            if(m_order[i].item == item){
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    VariantMenuPage::Slot* VariantMenuPage::takeSlot(){
+        if(m_free.empty()){
+            return &m_slots.emplace_back();
+        }
+        Slot* slot = m_free.back();
+        m_free.pop_back();
+        return slot;
+    }
+
+    void VariantMenuPage::addItem(IMenuItem* item){
+        if(!item){
+            throw std::invalid_argument("VariantMenuPage: Cannot add null item");
+        }
+
+        Slot* slot = takeSlot();
+        slot->emplace<IMenuItem*>(item);
+        m_order.push_back(Entry{item, slot, Extension});
+        MenuPage::addItem(item);
+    }
+
+    bool VariantMenuPage::removeItem(IMenuItem* item){
+        int index = findSlot(item);
+        if(index < 0 || !detachItem(item)){
+            return false;
+        }
+
+        Entry entry = m_order[index];
+        m_order.erase(m_order.begin() + index);
+
+        if(entry.kind == Extension && !item->isArenaAllocated()){
+            delete item;
+        }
+        entry.slot->emplace<std::monostate>();
+        m_free.push_back(entry.slot);
+        return true;
+    }
+
+    bool VariantMenuPage::isInlineAt(int index) const{
+        return m_order[index].kind != Extension;
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "menulib/MenuOption.hpp"
+#include "menulib/MenuPage.hpp"
+#include "menulib/MenuSlider.hpp"
+#include "menulib/MenuToggle.hpp"
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <string>
+
+namespace test{
+
+    /**
+    * @brief Count of failed checks of the running test program.
+    */
+    inline int& failures(){
+        static int count = 0;
+        return count;
+    }
+
+    /**
+    * @brief Reports a failed condition, the test goes on
+    */
+    inline void check(bool passed, const char* condition, const char* file, int line){
+        if(!passed){
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+            failures()++;
+        }
+    }
+
+    /**
+    * @brief Runs one case, an escaping exception counts as a failure
+    *
+    * @param name case name, dotted like "index.relabel"
+    * @param body function doing the checks
+    */
+    template <typename F>
+    void run(const char* name, F body){
+        int before = failures();
+        try{
+            body();
+        }
+        catch(const std::exception& e){
+            std::fprintf(stderr, "%s: unexpected exception: %s\n", name, e.what());
+            failures()++;
+        }
+        std::printf("%-48s %s\n", name, failures() == before ? "ok" : "FAILED");
+    }
+
+    /**
+    * @brief Returns the exit code of the test program, non-zero if any check failed
+    */
+    inline int finish(){
+        return failures() == 0 ? 0 : 1;
+    }
+
+    /**
+    * @brief File in the temporary directory, removed on construction and destruction
+    */
+    class TempFile{
+        private:
+            std::filesystem::path m_path;
+
+        public:
+            explicit TempFile(const std::string& name)
+                : m_path(std::filesystem::temp_directory_path() / ("menulib_test_" + name)){
+                std::filesystem::remove(m_path);
+            }
+
+            ~TempFile(){
+                std::error_code error;
+                std::filesystem::remove(m_path, error);
+            }
+
+            TempFile(const TempFile&) = delete;
+            TempFile& operator=(const TempFile&) = delete;
+
+            std::string path() const{
+                return m_path.string();
+            }
+    };
+
+    /**
+    * @brief Small tree shared by the tests, built the same way every time.
+    *
+    * Root: Start, Settings (Sound, Volume, Audio (X, Y)), Help (Topic)
+    */
+    struct Tree{
+        mr::MenuPage root {"Root"};
+        mr::MenuPage* settings {new mr::MenuPage("Settings", &root)};
+        mr::MenuToggle* sound {new mr::MenuToggle("Sound", true, [](bool){})};
+        mr::MenuSlider<int>* volume {new mr::MenuSlider<int>("Volume", 5, 0, 10, 1, [](int){})};
+        mr::MenuPage* audio {new mr::MenuPage("Audio", settings)};
+        mr::MenuPage* help {new mr::MenuPage("Help", &root)};
+
+        Tree(){
+            audio->addItem(new mr::MenuOption("X", []{}));
+            audio->addItem(new mr::MenuOption("Y", []{}));
+            settings->addItem(sound);
+            settings->addItem(volume);
+            settings->addItem(audio);
+            help->addItem(new mr::MenuOption("Topic", []{}));
+            root.addItem(new mr::MenuOption("Start", []{}));
+            root.addItem(settings);
+            root.addItem(help);
+        }
+    };
+}
+
+/**
+* @brief Checks a condition, printing it with its location when it does not hold.
+*/
+#define MENULIB_CHECK(condition) ::test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,102 @@
+#include "TestHarness.hpp"
+#include "menulib/IMenuObserver.hpp"
+#include "menulib/MenuEventQueue.hpp"
+#include "menulib/MenuLoop.hpp"
+#include "menulib/MenuNavigator.hpp"
+#include "menulib/MenuRenderer.hpp"
+#include "menulib/MenuThreadPool.hpp"
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace{
+
+    /**
+    * @brief Records the labels announced through onLabelChanged()
+    */
+    struct LabelLog : mr::IMenuObserver{
+        std::vector<std::string> labels {};
+
+        void onLabelChanged(mr::IMenuItem* item) override{
+            // getLabel() caches in the item, appendLabel() is safe from the worker thread
+            std::string label;
+            item->appendLabel(label);
+            labels.push_back(std::move(label));
+        }
+    };
+
+    /**
+    * @brief Waits until the only worker of the pool finished everything queued before
+    */
+    void drain(mr::MenuThreadPool& pool){
+        std::atomic<bool> reached {};
+        pool.submit([&reached]{ reached = true; });
+        while(!reached){
+            std::this_thread::yield();
+        }
+    }
+}
+
+int main(){
+    test::run("async.status_changes_announced", []{
+        mr::MenuPage root("Root");
+        auto* load = new mr::MenuOption("Load", []{});
+        root.addItem(load);
+
+        LabelLog log;
+        root.addObserver(&log);
+
+        mr::MenuThreadPool pool(1);
+        load->setAsync(&pool);
+        mr::MenuNavigator navigator(&root);
+        navigator.select();
+        load->wait();
+        drain(pool);
+
+        root.removeObserver(&log);
+        // a short action may already be done when running is announced
+        MENULIB_CHECK(log.labels.size() == 3);
+        MENULIB_CHECK(log.labels.front() == "Load [queued]");
+        MENULIB_CHECK(log.labels.back() == "Load [done]");
+    });
+
+    test::run("async.finished_action_drawn_without_input", []{
+        mr::MenuPage root("Root");
+        std::atomic<bool> release {};
+        auto* load = new mr::MenuOption("Load", [&release]{
+            while(!release){
+                std::this_thread::yield();
+            }
+        });
+        root.addItem(load);
+
+        mr::MenuThreadPool pool(1);
+        load->setAsync(&pool);
+        mr::MenuNavigator navigator(&root);
+        mr::MenuEventQueue events(&navigator);
+        mr::MenuRenderer renderer;
+        std::ostringstream out;
+        mr::MenuLoop loop(&navigator, &events, &renderer, out);
+
+        MENULIB_CHECK(loop.tick());
+        events.post(mr::MenuEvent::Select);
+        MENULIB_CHECK(loop.tick());
+        while(load->getStatus() != mr::ActionStatus::Running){
+            std::this_thread::yield();
+        }
+        loop.tick();
+
+        release = true;
+        load->wait();
+        drain(pool);
+        out.str("");
+        MENULIB_CHECK(loop.tick());
+        // only the changed part of the line is redrawn
+        MENULIB_CHECK(out.str().find("done]") != std::string::npos);
+        MENULIB_CHECK(!loop.tick());
+    });
+
+    return test::finish();
+}
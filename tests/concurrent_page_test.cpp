@@ -0,0 +1,132 @@
+#include "TestHarness.hpp"
+#include "menulib/ConcurrentMenuPage.hpp"
+#include "menulib/IMenuObserver.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace{
+
+    std::atomic<int> s_destroyed {};
+
+    /**
+    * @brief Option counting its destructions
+    */
+    struct CountedOption : mr::MenuOption{
+        explicit CountedOption(std::string_view label) : mr::MenuOption(label, []{}){}
+
+        ~CountedOption() override{
+            s_destroyed++;
+        }
+    };
+
+    /**
+    * @brief Counts the items announced added and removed
+    */
+    struct ItemLog : mr::IMenuObserver{
+        int added {};
+        int removed {};
+
+        void onItemAdded(mr::MenuPage* page, mr::IMenuItem* item) override{
+            added++;
+        }
+
+        void onItemRemoved(mr::MenuPage* page, mr::IMenuItem* item) override{
+            removed++;
+        }
+    };
+}
+
+int main(){
+    test::run("concurrent.guard_keeps_removed_item", []{
+        s_destroyed = 0;
+        mr::ConcurrentMenuPage page("Devices");
+        auto* usb = new CountedOption("USB");
+        page.addItem(new CountedOption("Disk"));
+        page.addItem(usb);
+        page.addItem(new CountedOption("Network"));
+
+        {
+            mr::MenuPage::ReadGuard guard(page);
+            MENULIB_CHECK(page.removeItem(usb));
+            MENULIB_CHECK(!page.removeItem(usb));
+
+            // the pinned snapshot still lists the item, and it is still alive
+            MENULIB_CHECK(guard.count() == 3);
+            MENULIB_CHECK(guard.at(1)->getLabel() == "USB");
+            MENULIB_CHECK(page.getCount() == 2);
+            MENULIB_CHECK(page.getRetiredCount() == 1);
+            MENULIB_CHECK(s_destroyed == 0);
+        }
+
+        MENULIB_CHECK(page.reclaim() == 1);
+        MENULIB_CHECK(page.getRetiredCount() == 0);
+        MENULIB_CHECK(s_destroyed == 1);
+        MENULIB_CHECK(page.getItem(1)->getLabel() == "Network");
+        MENULIB_CHECK(page.getItems().empty());
+    });
+
+    test::run("concurrent.observers_see_writes", []{
+        mr::ConcurrentMenuPage page("Devices");
+        ItemLog log;
+        page.addObserver(&log);
+
+        auto* disk = new CountedOption("Disk");
+        page.addItem(disk);
+        page.addItem(new CountedOption("USB"));
+        page.removeItem(disk);
+
+        page.removeObserver(&log);
+        MENULIB_CHECK(log.added == 2);
+        MENULIB_CHECK(log.removed == 1);
+    });
+
+    test::run("concurrent.readers_during_writes", []{
+        s_destroyed = 0;
+        const int rounds = 2000;
+        {
+            mr::ConcurrentMenuPage page("Devices");
+            page.addItem(new CountedOption("Fixed"));
+            std::atomic<bool> done {};
+            std::atomic<bool> consistent {true};
+
+            std::vector<std::thread> readers;
+            for(int r = 0; r < 2; ++r){
+                readers.emplace_back([&]{
+                    while(!done){
+                        mr::MenuPage::ReadGuard guard(page);
+                        // one hotplugged item at most, the fixed one always first
+                        if(guard.count() < 1 || guard.count() > 2 || guard.at(0)->getBaseLabel() != "Fixed"){
+                            consistent = false;
+                        }
+                        for(int i = 0; i < guard.count(); ++i){
+                            if(guard.at(i)->getBaseLabel().empty()){
+                                consistent = false;
+                            }
+                        }
+                    }
+                });
+            }
+
+            for(int i = 0; i < rounds; ++i){
+                auto* item = new CountedOption("Hotplug " + std::to_string(i));
+                page.addItem(item);
+                page.removeItem(item);
+            }
+            done = true;
+            for(std::thread& reader : readers){
+                reader.join();
+            }
+
+            MENULIB_CHECK(consistent);
+            page.reclaim();
+            MENULIB_CHECK(page.getRetiredCount() == 0);
+            MENULIB_CHECK(s_destroyed == rounds);
+            MENULIB_CHECK(page.getCount() == 1);
+        }
+        MENULIB_CHECK(s_destroyed == rounds + 1);
+    });
+
+    return test::finish();
+}
@@ -0,0 +1,123 @@
+#include "TestHarness.hpp"
+#include "menulib/InplaceFunction.hpp"
+#include <array>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace{
+
+    using Function = mr::InplaceFunction<int(int), 32>;
+
+    /**
+    * @brief Callable counting its live copies
+    */
+    struct Counted{
+        int* live;
+        int offset;
+
+        Counted(int* live, int offset) : live(live), offset(offset){
+            ++*live;
+        }
+
+        Counted(Counted&& other) noexcept : live(other.live), offset(other.offset){
+            ++*live;
+        }
+
+        ~Counted(){
+            --*live;
+        }
+
+        int operator()(int value) const{
+            return value + offset;
+        }
+    };
+
+    int twice(int value){
+        return 2 * value;
+    }
+
+    static_assert(!std::is_copy_constructible<Function>::value);
+    static_assert(std::is_nothrow_move_constructible<Function>::value);
+    static_assert(sizeof(mr::MenuCallback<void()>) >= MENULIB_CALLBACK_CAPACITY);
+}
+
+int main(){
+    test::run("inplace.empty_function", []{
+        Function empty;
+        MENULIB_CHECK(!empty);
+        Function null(nullptr);
+        MENULIB_CHECK(!null);
+
+        int (*pointer)(int) = nullptr;
+        MENULIB_CHECK(!Function(pointer));
+        MENULIB_CHECK(!Function(std::function<int(int)>()));
+        MENULIB_CHECK(Function(&twice)(4) == 8);
+
+        bool threw = false;
+        try{
+            empty(1);
+        }
+        catch(const std::bad_function_call&){
+            threw = true;
+        }
+        MENULIB_CHECK(threw);
+    });
+
+    test::run("inplace.move_leaves_source_empty", []{
+        int live = 0;
+        {
+            Function source(Counted(&live, 10));
+            MENULIB_CHECK(live == 1);
+
+            Function moved(std::move(source));
+            MENULIB_CHECK(!source);
+            MENULIB_CHECK(moved(1) == 11);
+            MENULIB_CHECK(live == 1);
+
+            Function assigned(Counted(&live, 20));
+            MENULIB_CHECK(live == 2);
+            assigned = std::move(moved);
+            MENULIB_CHECK(!moved);
+            MENULIB_CHECK(assigned(1) == 11);
+            MENULIB_CHECK(live == 1);
+
+            // self-assignment keeps the callable
+            Function& alias = assigned;
+            assigned = std::move(alias);
+            MENULIB_CHECK(assigned(2) == 12);
+
+            // moving an empty function empties the target
+            assigned = std::move(source);
+            MENULIB_CHECK(!assigned);
+            MENULIB_CHECK(live == 0);
+        }
+        MENULIB_CHECK(live == 0);
+    });
+
+    test::run("inplace.reset_destroys_callable", []{
+        int live = 0;
+        Function function(Counted(&live, 1));
+        function = nullptr;
+        MENULIB_CHECK(!function);
+        MENULIB_CHECK(live == 0);
+
+        function = Function(Counted(&live, 2));
+        function.reset();
+        MENULIB_CHECK(live == 0);
+    });
+
+    test::run("inplace.capture_fills_capacity", []{
+        std::array<char, 32> bytes {};
+        bytes[31] = 7;
+        Function function([bytes](int value){ return value + bytes[31]; });
+        MENULIB_CHECK(function(1) == 8);
+
+        // move-only arguments are forwarded
+        mr::InplaceFunction<int(std::unique_ptr<int>), 16> take([](std::unique_ptr<int> value){ return *value; });
+        MENULIB_CHECK(take(std::make_unique<int>(5)) == 5);
+    });
+
+    return test::finish();
+}
@@ -0,0 +1,76 @@
+#include "TestHarness.hpp"
+#include "menulib/FrozenMenu.hpp"
+#include "menulib/MenuActionRegistry.hpp"
+#include "menulib/MenuBinary.hpp"
+#include "menulib/MenuIndex.hpp"
+#include "menulib/MenuNavigator.hpp"
+#include "menulib/MenuReplayer.hpp"
+#include "menulib/MenuSearchIndex.hpp"
+#include "menulib/MenuSettings.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+int main(){
+    test::run("binary.round_trip", []{
+        test::TempFile file("tree.menu");
+        test::Tree tree;
+        tree.volume->setValue(7);
+        mr::MenuBinary::save(tree.root, file.path(), {{tree.root.getItems()[0], "start"}});
+
+        int started = 0;
+        mr::MenuActionRegistry registry;
+        registry.addAction("start", [&started]{ started++; });
+
+        mr::MenuBinary binary(file.path(), &registry);
+        MENULIB_CHECK(binary.getNodeCount() == 10);
+        MENULIB_CHECK(binary.getLabel(0) == "Root");
+        MENULIB_CHECK(binary.getKind(2) == mr::ItemKind::Page);
+        MENULIB_CHECK(mr::MenuReplayer::stateHash(binary.getRoot()) == mr::MenuReplayer::stateHash(&tree.root));
+
+        mr::MenuNavigator navigator(binary.getRoot());
+        navigator.select();
+        MENULIB_CHECK(started == 1);
+    });
+
+    test::run("binary.pages_are_not_lazy", []{
+        test::TempFile file("features.menu");
+        test::TempFile journal("features.journal");
+        test::Tree tree;
+        mr::MenuBinary::save(tree.root, file.path());
+        mr::MenuBinary binary(file.path());
+        mr::MenuPage* root = binary.getRoot();
+        MENULIB_CHECK(!root->isLazy());
+
+        // features walking the tree see the children of mapped pages
+        mr::MenuIndex index(root);
+        MENULIB_CHECK(index.size() == 9);
+        MENULIB_CHECK(index.find(std::string_view("Settings/Audio/Y")).index == 1);
+
+        mr::MenuSettings settings(root, journal.path());
+        MENULIB_CHECK(settings.find("Settings/Volume") != nullptr);
+
+        mr::MenuSearchIndex search(root);
+        MENULIB_CHECK(!search.query("topic").empty());
+
+        mr::FrozenMenu frozen(root);
+        MENULIB_CHECK(frozen.getNodeCount() == 10);
+    });
+
+    test::run("binary.malformed_file_rejected", []{
+        test::TempFile file("bad.menu");
+        std::ofstream(file.path(), std::ios::binary) << "not a menu file at all, just text";
+
+        bool rejected = false;
+        try{
+            mr::MenuBinary binary(file.path());
+        }
+        catch(const std::runtime_error&){
+            rejected = true;
+        }
+        MENULIB_CHECK(rejected);
+    });
+
+    return test::finish();
+}
@@ -0,0 +1,99 @@
+#include "TestHarness.hpp"
+#include "menulib/MenuIndex.hpp"
+#include "menulib/MenuNavigator.hpp"
+#include <string_view>
+
+namespace{
+
+    mr::MenuOption* option(std::string_view label){
+        return new mr::MenuOption(label, []{});
+    }
+}
+
+int main(){
+    test::run("index.paths_and_ids", []{
+        test::Tree tree;
+        mr::MenuIndex index(&tree.root);
+        MENULIB_CHECK(index.size() == 9);
+        MENULIB_CHECK(index.getPath(tree.volume) == "Settings/Volume");
+        MENULIB_CHECK(index.find(std::string_view("Settings/Volume")).item == tree.volume);
+        MENULIB_CHECK(index.find(tree.volume->getId()).page == tree.settings);
+        MENULIB_CHECK(index.find(tree.volume->getId()).index == 1);
+        MENULIB_CHECK(index.find(tree.root.getId()).item == nullptr);
+
+        // '/' in a label is escaped
+        tree.audio->setLabel("Audio/Video");
+        MENULIB_CHECK(index.find(std::string_view("Settings/Audio\\/Video/Y")).index == 1);
+
+        // items added later are indexed too
+        mr::MenuOption* later = option("Later");
+        tree.audio->addItem(later);
+        MENULIB_CHECK(index.getPath(later) == "Settings/Audio\\/Video/Later");
+        MENULIB_CHECK(index.find(std::string_view("Settings/Audio\\/Video/Later")).index == 2);
+    });
+
+    test::run("index.rekeys_repeated_labels", []{
+        mr::MenuPage root("Root");
+        mr::MenuIndex index(&root);
+        mr::MenuOption* first = option("Volume");
+        mr::MenuOption* other = option("Other");
+        mr::MenuOption* second = option("Volume");
+        root.addItem(first);
+        root.addItem(other);
+        root.addItem(second);
+        MENULIB_CHECK(index.getPath(second) == "Volume#2");
+
+        // the survivor takes over the plain path and moves up a row
+        root.removeItem(first);
+        MENULIB_CHECK(index.getPath(second) == "Volume");
+        MENULIB_CHECK(index.find(std::string_view("Volume#2")).item == nullptr);
+        MENULIB_CHECK(index.find(std::string_view("Volume")).index == 1);
+        MENULIB_CHECK(index.find(std::string_view("Other")).index == 0);
+
+        // a relabelled item earlier in the page pushes the other one to "#2"
+        other->setLabel("Volume");
+        MENULIB_CHECK(index.getPath(other) == "Volume");
+        MENULIB_CHECK(index.getPath(second) == "Volume#2");
+        MENULIB_CHECK(index.find(second->getId()).item == second);
+    });
+
+    test::run("index.relabelled_page_rekeys_subtree", []{
+        test::Tree tree;
+        mr::MenuIndex index(&tree.root);
+
+        tree.settings->setLabel("Config");
+        MENULIB_CHECK(index.getPath(tree.volume) == "Config/Volume");
+        MENULIB_CHECK(index.find(std::string_view("Config/Audio/X")).item != nullptr);
+        MENULIB_CHECK(index.find(std::string_view("Settings/Volume")).item == nullptr);
+
+        // a removed page takes its subtree along
+        mr::ItemId id = tree.volume->getId();
+        tree.root.removeItem(tree.settings);
+        MENULIB_CHECK(index.find(id).item == nullptr);
+        MENULIB_CHECK(index.size() == 3);
+    });
+
+    test::run("index.jump_to", []{
+        test::Tree tree;
+        mr::MenuIndex index(&tree.root);
+        mr::MenuNavigator navigator(&tree.root);
+
+        MENULIB_CHECK(navigator.jumpTo(index, std::string_view("Settings/Audio/Y")));
+        MENULIB_CHECK(navigator.getCurrentMenu() == tree.audio);
+        MENULIB_CHECK(navigator.getCurrentIndex() == 1);
+
+        navigator.root();
+        MENULIB_CHECK(navigator.jumpTo(index, tree.volume->getId()));
+        MENULIB_CHECK(navigator.getCurrentItem() == tree.volume);
+        MENULIB_CHECK(!navigator.jumpTo(index, std::string_view("Settings/Mute")));
+
+        // items of another tree are not reachable
+        mr::MenuPage other("Other");
+        mr::MenuOption* stranger = option("Stranger");
+        other.addItem(stranger);
+        MENULIB_CHECK(!navigator.jumpTo(stranger));
+        MENULIB_CHECK(navigator.getCurrentItem() == tree.volume);
+    });
+
+    return test::finish();
+}
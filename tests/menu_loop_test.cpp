@@ -0,0 +1,57 @@
+#include "TestHarness.hpp"
+#include "menulib/MenuEventQueue.hpp"
+#include "menulib/MenuLoop.hpp"
+#include "menulib/MenuNavigator.hpp"
+#include "menulib/MenuRenderer.hpp"
+#include <sstream>
+#include <thread>
+
+int main(){
+    test::run("loop.stop_before_run_is_kept", []{
+        test::Tree tree;
+        mr::MenuNavigator navigator(&tree.root);
+        mr::MenuEventQueue events(&navigator);
+        mr::MenuRenderer renderer;
+        std::ostringstream out;
+        mr::MenuLoop loop(&navigator, &events, &renderer, out);
+
+        loop.setTargetFrameRate(10000.0);
+        // a lost stop() would let run() go on, the hook ends it anyway
+        loop.setFrameHook([&loop](const mr::FrameTimings& timings){
+            if(timings.frame >= 100){
+                loop.stop();
+            }
+        });
+
+        std::thread stopper([&loop]{ loop.stop(); });
+        stopper.join();
+        loop.run();
+        MENULIB_CHECK(loop.getStats().frames == 0);
+        MENULIB_CHECK(!loop.isRunning());
+
+        // the request was used up, the next run() runs until stopped again
+        loop.run();
+        MENULIB_CHECK(loop.getStats().frames == 101);
+    });
+
+    test::run("loop.observes_navigator_root", []{
+        test::Tree tree;
+        mr::MenuNavigator navigator(tree.settings);
+        navigator.last();
+        navigator.select();
+        mr::MenuEventQueue events(&navigator);
+        mr::MenuRenderer renderer;
+        std::ostringstream out;
+        mr::MenuLoop loop(&navigator, &events, &renderer, out);
+        MENULIB_CHECK(loop.tick());
+        MENULIB_CHECK(!loop.tick());
+
+        // changes outside the navigated subtree are not drawn, changes inside are
+        tree.help->getItem(0)->setLabel("Manual");
+        MENULIB_CHECK(!loop.tick());
+        tree.sound->setLabel("Audio Out");
+        MENULIB_CHECK(loop.tick());
+    });
+
+    return test::finish();
+}
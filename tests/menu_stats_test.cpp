@@ -0,0 +1,44 @@
+#include "TestHarness.hpp"
+#include "menulib/MenuStats.hpp"
+
+int main(){
+    test::run("stats.relabelled_item_keeps_its_slot", []{
+        mr::MenuStats::reset();
+        mr::MenuOption option("Load", []{});
+
+        mr::MenuStats::record(&option, mr::MenuStats::Event::Select, 100);
+        option.setLabel("Reload");
+        mr::MenuStats::record(&option, mr::MenuStats::Event::Select, 300);
+
+        mr::MenuStats::Snapshot snapshot = mr::MenuStats::snapshot();
+        MENULIB_CHECK(snapshot.items.size() == 1);
+        if(!snapshot.items.empty()){
+            const mr::MenuStats::ItemStats& stats = snapshot.items.front();
+            MENULIB_CHECK(stats.item == &option);
+            MENULIB_CHECK(stats.label == "Load");
+            MENULIB_CHECK(stats.events[0].count == 2);
+            MENULIB_CHECK(stats.events[0].totalNs == 400);
+        }
+    });
+
+    test::run("stats.items_told_apart_by_id", []{
+        mr::MenuStats::reset();
+
+        // the second option may or may not reuse the first one's address
+        auto* first = new mr::MenuOption("First", []{});
+        mr::MenuStats::record(first, mr::MenuStats::Event::Callback, 10);
+        delete first;
+        auto* second = new mr::MenuOption("Second", []{});
+        mr::MenuStats::record(second, mr::MenuStats::Event::Callback, 10, 2);
+
+        mr::MenuStats::Snapshot snapshot = mr::MenuStats::snapshot();
+        MENULIB_CHECK(snapshot.items.size() == 2);
+        if(snapshot.items.size() == 2){
+            MENULIB_CHECK(snapshot.items[0].label == "Second");
+            MENULIB_CHECK(snapshot.items[1].label == "First");
+        }
+        delete second;
+    });
+
+    return test::finish();
+}
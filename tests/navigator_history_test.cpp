@@ -0,0 +1,115 @@
+#include "TestHarness.hpp"
+#include "menulib/FrozenMenu.hpp"
+#include "menulib/MenuNavigator.hpp"
+
+namespace{
+
+    /**
+    * @brief Enters Settings, then Audio, and highlights Y
+    */
+    void enterAudio(mr::MenuNavigator& navigator){
+        navigator.next();
+        navigator.select();
+        navigator.last();
+        navigator.select();
+        navigator.next();
+    }
+
+    /**
+    * @brief Checks back() and forward() restore the highlights, for both navigator modes
+    */
+    void checkBackForward(mr::MenuNavigator& navigator){
+        enterAudio(navigator);
+        MENULIB_CHECK(navigator.getDepth() == 2);
+        MENULIB_CHECK(navigator.getCurrentIndex() == 1);
+        MENULIB_CHECK(!navigator.canGoForward());
+
+        navigator.back();
+        MENULIB_CHECK(navigator.getCurrentTitle() == "Settings");
+        MENULIB_CHECK(navigator.getCurrentIndex() == 2);
+        navigator.back();
+        MENULIB_CHECK(navigator.getDepth() == 0);
+        MENULIB_CHECK(navigator.getCurrentIndex() == 1);
+
+        MENULIB_CHECK(navigator.forward());
+        MENULIB_CHECK(navigator.getCurrentTitle() == "Settings");
+        MENULIB_CHECK(navigator.getCurrentIndex() == 2);
+        MENULIB_CHECK(navigator.forward());
+        MENULIB_CHECK(navigator.getCurrentTitle() == "Audio");
+        MENULIB_CHECK(navigator.getCurrentIndex() == 1);
+        MENULIB_CHECK(!navigator.forward());
+    }
+}
+
+int main(){
+    test::run("history.back_forward", []{
+        test::Tree tree;
+        mr::MenuNavigator navigator(&tree.root);
+        checkBackForward(navigator);
+    });
+
+    test::run("history.back_forward_frozen", []{
+        test::Tree tree;
+        mr::FrozenMenu frozen(&tree.root);
+        mr::MenuNavigator navigator(&frozen);
+        checkBackForward(navigator);
+    });
+
+    test::run("history.entering_another_page_forgets_forward", []{
+        test::Tree tree;
+        mr::MenuNavigator navigator(&tree.root);
+        enterAudio(navigator);
+        navigator.root();
+        MENULIB_CHECK(navigator.canGoForward());
+
+        navigator.last();
+        navigator.select();
+        MENULIB_CHECK(navigator.getCurrentTitle() == "Help");
+        MENULIB_CHECK(!navigator.canGoForward());
+        MENULIB_CHECK(!navigator.forward());
+    });
+
+    test::run("history.forward_of_removed_submenu", []{
+        test::Tree tree;
+        mr::MenuNavigator navigator(&tree.root);
+        enterAudio(navigator);
+        navigator.back();
+
+        tree.settings->removeItem(tree.audio);
+        MENULIB_CHECK(!navigator.forward());
+        MENULIB_CHECK(navigator.getCurrentTitle() == "Settings");
+    });
+
+    test::run("history.depth_is_bounded", []{
+        // each page holds a filler and the next page, entered from its second row
+        mr::MenuPage root("Root");
+        mr::MenuPage* page = &root;
+        const int levels = mr::MenuNavigator::HistoryDepth + 4;
+        for(int i = 0; i < levels; ++i){
+            auto* child = new mr::MenuPage("Level", page);
+            page->addItem(new mr::MenuOption("Filler", []{}));
+            page->addItem(child);
+            page = child;
+        }
+
+        mr::MenuNavigator navigator(&root);
+        for(int i = 0; i < levels; ++i){
+            navigator.last();
+            navigator.select();
+        }
+        MENULIB_CHECK(navigator.getDepth() == levels);
+
+        // back() past the remembered steps still highlights the submenu left
+        navigator.root();
+        MENULIB_CHECK(navigator.getDepth() == 0);
+        MENULIB_CHECK(navigator.getCurrentIndex() == 1);
+
+        int redone = 0;
+        while(navigator.forward()){
+            redone++;
+        }
+        MENULIB_CHECK(redone == mr::MenuNavigator::HistoryDepth);
+    });
+
+    return test::finish();
+}
@@ -0,0 +1,133 @@
+#include "TestHarness.hpp"
+#include "menulib/DeferredMenuPage.hpp"
+#include "menulib/MenuNavigator.hpp"
+#include "menulib/MenuPrefetcher.hpp"
+#include "menulib/MenuThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace{
+
+    /**
+    * @brief Holds the only worker of a pool until released
+    */
+    struct Gate{
+        std::mutex mutex {};
+        std::condition_variable opened {};
+        bool open {};
+
+        void hold(mr::MenuThreadPool& pool){
+            pool.submit([this]{
+                std::unique_lock<std::mutex> lock(mutex);
+                opened.wait(lock, [this]{ return open; });
+            });
+        }
+
+        void release(){
+            std::lock_guard<std::mutex> lock(mutex);
+            open = true;
+            opened.notify_all();
+        }
+    };
+
+    /**
+    * @brief Root with an option and a deferred page, the page highlighted
+    */
+    struct DeferredTree{
+        mr::MenuPage root {"Root"};
+        mr::DeferredMenuPage* page {};
+
+        explicit DeferredTree(const mr::DeferredMenuPage::Builder& builder){
+            root.addItem(new mr::MenuOption("Start", []{}));
+            page = new mr::DeferredMenuPage("Deferred", builder, &root);
+            root.addItem(page);
+        }
+    };
+}
+
+int main(){
+    test::run("prefetch.queued_prefetch_of_removed_page_is_skipped", []{
+        std::atomic<int> builds {};
+        DeferredTree tree([&builds](std::vector<mr::IMenuItem*>& items){
+            builds++;
+            items.push_back(new mr::MenuOption("Built", []{}));
+        });
+        mr::MenuNavigator navigator(&tree.root);
+        navigator.next();
+
+        mr::MenuThreadPool pool(1);
+        mr::MenuPrefetcher prefetcher(&pool, mr::MenuPrefetcher::Clock::duration::zero());
+        Gate gate;
+        gate.hold(pool);
+
+        MENULIB_CHECK(prefetcher.update(navigator));
+        MENULIB_CHECK(tree.root.removeItem(tree.page));
+        gate.release();
+        prefetcher.wait();
+
+        MENULIB_CHECK(builds == 0);
+        MENULIB_CHECK(prefetcher.getInFlightCount() == 0);
+    });
+
+    test::run("prefetch.removing_page_waits_for_running_prefetch", []{
+        std::atomic<bool> running {};
+        std::atomic<bool> finished {};
+        DeferredTree tree([&](std::vector<mr::IMenuItem*>& items){
+            running = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            items.push_back(new mr::MenuOption("Built", []{}));
+            finished = true;
+        });
+        mr::MenuNavigator navigator(&tree.root);
+        navigator.next();
+
+        mr::MenuThreadPool pool(1);
+        mr::MenuPrefetcher prefetcher(&pool, mr::MenuPrefetcher::Clock::duration::zero());
+        MENULIB_CHECK(prefetcher.update(navigator));
+        while(!running){
+            std::this_thread::yield();
+        }
+
+        // the built but never added item is deleted by the page, leaks show under ASan
+        MENULIB_CHECK(tree.root.removeItem(tree.page));
+        MENULIB_CHECK(finished);
+        prefetcher.wait();
+    });
+
+    test::run("prefetch.failed_prefetch_retried_on_next_visit", []{
+        std::atomic<int> builds {};
+        DeferredTree tree([&builds](std::vector<mr::IMenuItem*>& items){
+            if(builds++ == 0){
+                throw std::runtime_error("first build fails");
+            }
+            items.push_back(new mr::MenuOption("Built", []{}));
+        });
+        mr::MenuNavigator navigator(&tree.root);
+        navigator.next();
+
+        mr::MenuThreadPool pool(1);
+        mr::MenuPrefetcher prefetcher(&pool, mr::MenuPrefetcher::Clock::duration::zero());
+        MENULIB_CHECK(prefetcher.update(navigator));
+        prefetcher.wait();
+        MENULIB_CHECK(!tree.page->isPrefetched());
+
+        // staying on the page does not hammer a failing builder
+        MENULIB_CHECK(!prefetcher.update(navigator));
+
+        navigator.previous();
+        MENULIB_CHECK(!prefetcher.update(navigator));
+        navigator.next();
+        MENULIB_CHECK(prefetcher.update(navigator));
+        prefetcher.wait();
+
+        MENULIB_CHECK(tree.page->isPrefetched());
+        MENULIB_CHECK(builds == 2);
+        MENULIB_CHECK(prefetcher.getStartedCount() == 2);
+    });
+
+    return test::finish();
+}
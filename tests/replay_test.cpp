@@ -0,0 +1,80 @@
+#include "TestHarness.hpp"
+#include "menulib/MenuEventQueue.hpp"
+#include "menulib/MenuNavigator.hpp"
+#include "menulib/MenuRecorder.hpp"
+#include "menulib/MenuReplayer.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+int main(){
+    test::run("replay.same_hash_as_session", []{
+        test::TempFile trace("replay.trc");
+
+        test::Tree live;
+        std::uint64_t initial = mr::MenuReplayer::stateHash(&live.root);
+
+        mr::MenuNavigator navigator(&live.root);
+        mr::MenuEventQueue queue(&navigator);
+        mr::MenuRecorder recorder;
+        queue.setRecorder(&recorder);
+
+        // enter Settings, flip Sound, raise Volume by three, look into Audio, leave
+        const std::vector<mr::MenuEvent> session {
+            mr::MenuEvent::Next, mr::MenuEvent::Select, mr::MenuEvent::Select,
+            mr::MenuEvent::Next, mr::MenuEvent::Right, mr::MenuEvent::Right,
+            mr::MenuEvent::Right, mr::MenuEvent::Left, mr::MenuEvent::Right,
+            mr::MenuEvent::Next, mr::MenuEvent::Select, mr::MenuEvent::Next,
+            mr::MenuEvent::Back, mr::MenuEvent::Back, mr::MenuEvent::Next
+        };
+        for(std::size_t i = 0; i < session.size(); ++i){
+            queue.post(session[i]);
+            // a few events per batch, so runs get coalesced like in a real session
+            if(i % 3 == 2){
+                queue.process();
+            }
+        }
+        queue.process();
+        recorder.save(trace.path());
+
+        std::uint64_t expected = mr::MenuReplayer::stateHash(&live.root);
+        MENULIB_CHECK(expected != initial);
+        MENULIB_CHECK(!live.sound->getState());
+        MENULIB_CHECK(live.volume->getValue() == 8);
+
+        mr::MenuReplayer replayer(trace.path());
+        MENULIB_CHECK(replayer.getEvents().size() == session.size());
+
+        for(mr::MenuReplayer::Speed speed : {mr::MenuReplayer::Speed::Unpaced, mr::MenuReplayer::Speed::Recorded}){
+            test::Tree fresh;
+            mr::MenuNavigator replayed(&fresh.root);
+
+            mr::ReplayResult result = replayer.replay(&replayed, speed);
+            MENULIB_CHECK(result.events == session.size());
+            MENULIB_CHECK(result.stateHash == expected);
+            MENULIB_CHECK(mr::MenuReplayer::stateHash(&fresh.root) == expected);
+        }
+    });
+
+    test::run("replay.trace_round_trip", []{
+        test::TempFile trace("roundtrip.trc");
+
+        // gaps of 100 us, 20 ms and 3 s take 2, 4 and 5 bytes
+        mr::MenuRecorder recorder;
+        recorder.record(mr::MenuEvent::Next, 100);
+        recorder.record(mr::MenuEvent::Select, 20100);
+        recorder.record(mr::MenuEvent::Back, 3020100);
+        recorder.save(trace.path());
+
+        MENULIB_CHECK(std::filesystem::file_size(trace.path()) == 20 + 2 + 4 + 5);
+
+        std::vector<mr::TraceEvent> events = mr::MenuRecorder::load(trace.path());
+        MENULIB_CHECK(events.size() == 3);
+        for(std::size_t i = 0; i < events.size() && i < recorder.getEvents().size(); ++i){
+            MENULIB_CHECK(events[i].event == recorder.getEvents()[i].event);
+            MENULIB_CHECK(events[i].timeUs == recorder.getEvents()[i].timeUs);
+        }
+    });
+
+    return test::finish();
+}
@@ -0,0 +1,258 @@
+#include "TestHarness.hpp"
+#include "menulib/MenuSettings.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+namespace{
+
+    void appendRaw(const std::string& path, const std::string& bytes){
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << bytes;
+    }
+
+    /**
+    * @brief Formats a journal line the way MenuSettings writes it, FNV-1a checksum first
+    */
+    std::string journalLine(const std::string& key, const std::string& value){
+        std::string payload = key + '\t' + value;
+        std::uint32_t hash = 2166136261u;
+        for(unsigned char c : payload){
+            hash ^= c;
+            hash *= 16777619u;
+        }
+        char checksum[9];
+        std::snprintf(checksum, sizeof(checksum), "%08x", static_cast<unsigned>(hash));
+        return std::string(checksum) + '\t' + payload + '\n';
+    }
+
+    std::string readRaw(const std::string& path){
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+}
+
+int main(){
+    test::run("journal.torn_tail_is_cut_off", []{
+        test::TempFile journal("torn.journal");
+        std::uintmax_t intact = 0;
+        {
+            test::Tree items;
+            mr::MenuSettings settings(&items.root, journal.path());
+            items.sound->setState(false);
+            items.volume->setValue(8);
+            MENULIB_CHECK(settings.save() == 2);
+            intact = std::filesystem::file_size(journal.path());
+        }
+
+        // a crash in the middle of the next append
+        appendRaw(journal.path(), "Settings/Vol");
+
+        test::Tree items;
+        mr::MenuSettings settings(&items.root, journal.path());
+        MENULIB_CHECK(settings.load() == 2);
+        MENULIB_CHECK(!items.sound->getState());
+        MENULIB_CHECK(items.volume->getValue() == 8);
+        MENULIB_CHECK(std::filesystem::file_size(journal.path()) == intact);
+
+        // the journal takes new records right after the intact part
+        items.volume->setValue(3);
+        MENULIB_CHECK(settings.save() == 1);
+
+        test::Tree again;
+        mr::MenuSettings store(&again.root, journal.path());
+        MENULIB_CHECK(store.load() == 2);
+        MENULIB_CHECK(again.volume->getValue() == 3);
+    });
+
+    test::run("journal.damaged_line_and_rest_dropped", []{
+        test::TempFile journal("damaged.journal");
+        std::uintmax_t firstSave = 0;
+        {
+            test::Tree items;
+            mr::MenuSettings settings(&items.root, journal.path());
+            items.volume->setValue(7);
+            settings.save();
+            firstSave = std::filesystem::file_size(journal.path());
+            items.volume->setValue(9);
+            settings.save();
+        }
+
+        // flip a byte of the last record, its checksum no longer matches
+        std::string content = readRaw(journal.path());
+        content[content.size() - 2] ^= 0x01;
+        std::ofstream(journal.path(), std::ios::binary | std::ios::trunc) << content;
+
+        test::Tree items;
+        mr::MenuSettings settings(&items.root, journal.path());
+        settings.load();
+        MENULIB_CHECK(items.volume->getValue() == 7);
+        MENULIB_CHECK(std::filesystem::file_size(journal.path()) == firstSave);
+    });
+
+    test::run("journal.save_without_load_keeps_values", []{
+        test::TempFile journal("unloaded.journal");
+        {
+            test::Tree items;
+            mr::MenuSettings settings(&items.root, journal.path());
+            items.sound->setState(false);
+            settings.save();
+        }
+
+        // a store that never loaded writes and compacts without losing Sound
+        {
+            test::Tree items;
+            mr::MenuSettings settings(&items.root, journal.path());
+            items.volume->setValue(1);
+            settings.save();
+            settings.compact();
+        }
+
+        test::Tree items;
+        mr::MenuSettings settings(&items.root, journal.path());
+        MENULIB_CHECK(settings.load() == 2);
+        MENULIB_CHECK(!items.sound->getState());
+        MENULIB_CHECK(items.volume->getValue() == 1);
+    });
+
+    test::run("journal.rekeyed_sibling_keeps_its_value", []{
+        test::TempFile journal("rekey.journal");
+        {
+            mr::MenuPage root("Root");
+            auto* first = new mr::MenuToggle("Mute", false, [](bool){});
+            auto* second = new mr::MenuToggle("Mute", false, [](bool){});
+            root.addItem(first);
+            root.addItem(second);
+            mr::MenuSettings settings(&root, journal.path());
+            settings.load();
+            second->setState(true);
+            settings.save();
+
+            // the survivor becomes "Mute" and its value follows it on the next save
+            root.removeItem(first);
+            MENULIB_CHECK(settings.getKey(second) == "Mute");
+            settings.save();
+        }
+
+        mr::MenuPage root("Root");
+        auto* only = new mr::MenuToggle("Mute", false, [](bool){});
+        root.addItem(only);
+        mr::MenuSettings settings(&root, journal.path());
+        settings.load();
+        MENULIB_CHECK(only->getState());
+    });
+
+    test::run("journal.hash_in_label_has_its_own_key", []{
+        test::TempFile journal("hash.journal");
+        {
+            mr::MenuPage root("Root");
+            auto* literal = new mr::MenuToggle("A#2", false, [](bool){});
+            auto* first = new mr::MenuToggle("A", false, [](bool){});
+            auto* second = new mr::MenuToggle("A", false, [](bool){});
+            root.addItem(literal);
+            root.addItem(first);
+            root.addItem(second);
+            mr::MenuSettings settings(&root, journal.path());
+            MENULIB_CHECK(settings.getKey(literal) == "A\\#2");
+            MENULIB_CHECK(settings.getKey(second) == "A#2");
+            MENULIB_CHECK(settings.find("A#2") == second);
+            MENULIB_CHECK(settings.find("A\\#2") == literal);
+
+            literal->setState(true);
+            settings.save();
+        }
+
+        mr::MenuPage root("Root");
+        auto* literal = new mr::MenuToggle("A#2", false, [](bool){});
+        auto* first = new mr::MenuToggle("A", false, [](bool){});
+        auto* second = new mr::MenuToggle("A", false, [](bool){});
+        root.addItem(literal);
+        root.addItem(first);
+        root.addItem(second);
+        mr::MenuSettings settings(&root, journal.path());
+        MENULIB_CHECK(settings.load() == 1);
+        MENULIB_CHECK(literal->getState());
+        MENULIB_CHECK(!first->getState());
+        MENULIB_CHECK(!second->getState());
+    });
+
+#ifndef _WIN32
+    test::run("journal.failed_append_is_cut_off", []{
+        test::TempFile journal("failed.journal");
+        test::Tree items;
+        mr::MenuSettings settings(&items.root, journal.path());
+        items.sound->setState(false);
+        settings.save();
+        std::uintmax_t intact = std::filesystem::file_size(journal.path());
+
+        // the file size limit lets a few bytes of the next record through, then the write fails
+        std::signal(SIGXFSZ, SIG_IGN);
+        rlimit previous {};
+        getrlimit(RLIMIT_FSIZE, &previous);
+        rlimit limited = previous;
+        limited.rlim_cur = static_cast<rlim_t>(intact + 4);
+        setrlimit(RLIMIT_FSIZE, &limited);
+
+        items.volume->setValue(9);
+        bool failed = false;
+        try{
+            settings.save();
+        }
+        catch(const std::runtime_error&){
+            failed = true;
+        }
+        setrlimit(RLIMIT_FSIZE, &previous);
+        std::signal(SIGXFSZ, SIG_DFL);
+
+        MENULIB_CHECK(failed);
+        MENULIB_CHECK(std::filesystem::file_size(journal.path()) == intact);
+        MENULIB_CHECK(settings.getDirtyCount() == 1);
+
+        // the retry lands on a clean line and survives a reload
+        MENULIB_CHECK(settings.save() == 1);
+        test::Tree again;
+        mr::MenuSettings store(&again.root, journal.path());
+        MENULIB_CHECK(store.load() == 2);
+        MENULIB_CHECK(!again.sound->getState());
+        MENULIB_CHECK(again.volume->getValue() == 9);
+    });
+#endif
+
+    test::run("journal.unusable_numbers_rejected", []{
+        test::TempFile journal("numbers.journal");
+        std::ofstream(journal.path(), std::ios::binary)
+            << "MENULIB-SETTINGS 1\n"
+            << journalLine("Settings/Volume", "nan")
+            << journalLine("Settings/Gain", "inf")
+            << journalLine("Help/Level", "-1e300");
+
+        test::Tree items;
+        auto* gain = new mr::MenuSlider<float>("Gain", 0.5f, 0.0f, 1.0f, 0.1f, [](float){});
+        auto* level = new mr::MenuSlider<int>("Level", 0, -5, 5, 1, [](int){});
+        items.settings->addItem(gain);
+        items.help->addItem(level);
+
+        // non-finite values are refused, huge ones clamped before the conversion
+        mr::MenuSettings settings(&items.root, journal.path());
+        MENULIB_CHECK(settings.load() == 1);
+        MENULIB_CHECK(items.volume->getValue() == 5);
+        MENULIB_CHECK(gain->getValue() == 0.5f);
+        MENULIB_CHECK(level->getValue() == -5);
+
+        gain->setNumericValue(1e300);
+        MENULIB_CHECK(gain->getValue() == 1.0f);
+        gain->setNumericValue(std::nan(""));
+        MENULIB_CHECK(gain->getValue() == 1.0f);
+    });
+
+    return test::finish();
+}
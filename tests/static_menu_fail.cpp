@@ -0,0 +1,27 @@
+#include "menulib/StaticMenu.hpp"
+
+// built once as is, which has to succeed, and once per STATIC_MENU_FAIL_* case,
+// which has to fail: every case breaks a single check of the declaration
+int main(){
+#if defined(STATIC_MENU_FAIL_RANGE_REVERSED)
+    constexpr auto menu = mr::ct::build(mr::ct::page("Root", mr::ct::slider("Volume", 5, 10, 0, 1)));
+#elif defined(STATIC_MENU_FAIL_VALUE_OUT_OF_BOUNDS)
+    constexpr auto menu = mr::ct::build(mr::ct::page("Root", mr::ct::slider("Volume", 11, 0, 10, 1)));
+#elif defined(STATIC_MENU_FAIL_STEP_NOT_POSITIVE)
+    constexpr auto menu = mr::ct::build(mr::ct::page("Root", mr::ct::slider("Gamma", 1.0, 0.5, 2.0, 0.0)));
+#elif defined(STATIC_MENU_FAIL_EMPTY_LABEL)
+    constexpr auto menu = mr::ct::build(mr::ct::page("Root", mr::ct::option("")));
+#elif defined(STATIC_MENU_FAIL_VALUE_TYPE)
+    constexpr auto menu = mr::ct::build(mr::ct::page("Root", mr::ct::slider<long>("Volume", 5, 0, 10, 1)));
+#else
+    constexpr auto menu = mr::ct::build(mr::ct::page("Root", mr::ct::slider("Volume", 5, 0, 10, 1)));
+#endif
+
+#if defined(STATIC_MENU_FAIL_TEMPORARY_MENU)
+    mr::ct::Navigator<decltype(menu)> navigator(decltype(menu){menu});
+#else
+    mr::ct::Navigator<decltype(menu)> navigator(menu);
+#endif
+    navigator.right();
+    return navigator.getValue(1) == 6.0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+#include "TestHarness.hpp"
+#include "menulib/StaticMenu.hpp"
+#include <string_view>
+
+namespace{
+
+    int s_started {};
+    bool s_sound {true};
+    int s_volume {};
+
+    constexpr auto s_menu = mr::ct::build(
+        mr::ct::page("Main Menu",
+            mr::ct::option("Start Game", []{ s_started++; }),
+            mr::ct::page("Settings",
+                mr::ct::toggle("Sound", true, [](bool on){ s_sound = on; }),
+                mr::ct::slider("Volume", 50, 0, 100, 5, [](int value){ s_volume = value; }),
+                mr::ct::slider("Gamma", 1.0, 0.5, 2.0, 0.25)),
+            mr::ct::page("Help")));
+
+    // the layout is fixed while compiling: breadth-first, children of a page next to each other
+    static_assert(decltype(s_menu)::nodeCount == 7);
+    static_assert(decltype(s_menu)::sliderCount == 2);
+    static_assert(s_menu.getChildCount(0) == 3);
+    static_assert(s_menu.getLabel(s_menu.getChild(0, 1)) == "Settings");
+    static_assert(s_menu.getChild(2, 0) == 4);
+    static_assert(s_menu.getParent(4) == 2);
+    static_assert(s_menu.getKind(5) == mr::ItemKind::Slider);
+    static_assert(s_menu.getSlider(6).numeric == mr::ct::Numeric::Double);
+}
+
+int main(){
+    test::run("static.navigates_like_runtime_menu", []{
+        mr::ct::Navigator<decltype(s_menu)> navigator(s_menu);
+        navigator.select();
+        MENULIB_CHECK(s_started == 1);
+
+        navigator.next();
+        navigator.select();
+        MENULIB_CHECK(navigator.getCurrentPage() == 2);
+        navigator.select();
+        MENULIB_CHECK(!s_sound);
+        MENULIB_CHECK(!navigator.getState(4));
+
+        char buffer[32];
+        navigator.next();
+        navigator.step(3);
+        MENULIB_CHECK(s_volume == 65);
+        MENULIB_CHECK(navigator.formatLabel(5, buffer, sizeof(buffer)) == "Volume < 65 >");
+
+        // stops at the bound
+        navigator.step(100);
+        MENULIB_CHECK(navigator.getValue(5) == 100.0);
+        MENULIB_CHECK(navigator.formatLabel(5, buffer, 8) == "Volume <");
+
+        navigator.back();
+        MENULIB_CHECK(navigator.getCurrentPage() == 0);
+        navigator.previous();
+        MENULIB_CHECK(navigator.getCurrentNode() == 3);
+    });
+
+    return test::finish();
+}
@@ -0,0 +1,128 @@
+#include "TestHarness.hpp"
+#include "menulib/MenuTextParser.hpp"
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace{
+
+    /**
+    * @brief Parses a definition with a fresh parser
+    */
+    std::unique_ptr<mr::MenuPage> parse(const std::string& text, const mr::MenuActionRegistry* registry = nullptr,
+                                        std::size_t maxDepth = 64){
+        std::istringstream input(text);
+        return mr::MenuTextParser(registry, maxDepth).parse(input);
+    }
+
+    /**
+    * @brief Checks a definition is rejected at the given position
+    */
+    void checkRejected(const std::string& text, std::size_t line, std::size_t column,
+                       const mr::MenuActionRegistry* registry = nullptr, std::size_t maxDepth = 64){
+        try{
+            parse(text, registry, maxDepth);
+            MENULIB_CHECK(false);
+        }
+        catch(const mr::MenuParseError& error){
+            MENULIB_CHECK(error.getLine() == line);
+            MENULIB_CHECK(error.getColumn() == column);
+        }
+    }
+}
+
+int main(){
+    test::run("parser.builds_all_item_types", []{
+        int started = 0;
+        bool sound = true;
+        double volume = 0.0;
+        mr::MenuActionRegistry registry;
+        registry.addAction("start", [&started]{ started++; });
+        registry.addToggle("sound", [&sound](bool state){ sound = state; });
+        registry.addSlider("volume", [&volume](double value){ volume = value; });
+
+        std::unique_ptr<mr::MenuPage> root = parse(R"({"label": "Main Menu", "items": [
+            {"type": "option", "label": "Start Game", "action": "start"},
+            {"type": "page", "label": "Settings", "items": [
+                {"type": "toggle", "label": "Sound", "state": true, "action": "sound"},
+                {"type": "slider", "label": "Volume", "numeric": "int",
+                 "value": 50, "min": 0, "max": 100, "step": 5, "action": "volume"},
+                {"type": "slider", "label": "Gamma", "numeric": "double", "value": 1.5, "min": 0.5, "max": 3}
+            ]},
+            {"type": "option", "label": "Caf\u00e9 \ud83c\udf75"}
+        ]})", &registry);
+
+        MENULIB_CHECK(root->getLabel() == "Main Menu");
+        MENULIB_CHECK(root->getCount() == 3);
+
+        auto* start = dynamic_cast<mr::MenuOption*>(root->getItem(0));
+        MENULIB_CHECK(start != nullptr);
+        start->execute();
+        MENULIB_CHECK(started == 1);
+
+        auto* settings = dynamic_cast<mr::MenuPage*>(root->getItem(1));
+        MENULIB_CHECK(settings != nullptr && settings->getCount() == 3);
+        auto* toggle = dynamic_cast<mr::MenuToggle*>(settings->getItem(0));
+        MENULIB_CHECK(toggle != nullptr && toggle->getState());
+        toggle->onSelect(nullptr);
+        MENULIB_CHECK(!sound);
+
+        auto* slider = dynamic_cast<mr::MenuSlider<int>*>(settings->getItem(1));
+        MENULIB_CHECK(slider != nullptr && slider->getValue() == 50 && slider->getMin() == 0);
+        slider->onRight(nullptr);
+        MENULIB_CHECK(slider->getValue() == 55);
+        MENULIB_CHECK(volume == 55.0);
+
+        auto* gamma = dynamic_cast<mr::MenuSlider<double>*>(settings->getItem(2));
+        MENULIB_CHECK(gamma != nullptr && gamma->getValue() == 1.5);
+
+        // \u escapes, surrogate pairs included, are stored as UTF-8
+        MENULIB_CHECK(root->getItem(2)->getLabel() == "Caf\xc3\xa9 \xf0\x9f\x8d\xb5");
+    });
+
+    test::run("parser.errors_report_position", []{
+        checkRejected("{\"label\": \"Root\",\n \"colour\": 1}", 2, 2);
+        checkRejected("{\"label\": \"Root\", \"items\": [\n  {\"type\": \"option\"}]}", 2, 3);
+        checkRejected("{\"label\": \"Root\", \"items\": [\n  {\"type\": \"widget\", \"label\": \"W\"}]}", 2, 3);
+        checkRejected("{\"label\": \"Root\"} {}", 1, 19);
+        checkRejected("{\"label\": \"Root\", \"items\": [{\"type\": \"slider\", \"label\": \"S\", "
+                      "\"min\": 0, \"max\": 1.5}]}", 1, 29);
+        checkRejected("{\"label\": \"Bad \\q\"}", 1, 16);
+        checkRejected("{\"label\": \"\\ud83c\"}", 1, 12);
+    });
+
+    test::run("parser.unknown_action_rejected", []{
+        mr::MenuActionRegistry registry;
+        registry.addAction("start", []{});
+        checkRejected("{\"label\": \"Root\", \"items\": [\n"
+                      "  {\"type\": \"option\", \"label\": \"Go\", \"action\": \"stop\"}]}", 2, 47, &registry);
+    });
+
+    test::run("parser.nesting_is_bounded", []{
+        const std::string nested = "{\"label\": \"A\", \"items\": [{\"type\": \"page\", \"label\": \"B\", \"items\": ["
+                                    "{\"type\": \"page\", \"label\": \"C\"}]}]}";
+        MENULIB_CHECK(parse(nested, nullptr, 2) != nullptr);
+        try{
+            parse(nested, nullptr, 1);
+            MENULIB_CHECK(false);
+        }
+        catch(const mr::MenuParseError&){}
+    });
+
+    test::run("parser.input_spanning_chunks", []{
+        // well past the reader's chunk size, with the error on the last line
+        const int count = 4000;
+        std::string text = "{\"label\": \"Root\", \"items\": [\n";
+        for(int i = 0; i < count; ++i){
+            text += "  {\"type\": \"option\", \"label\": \"Option " + std::to_string(i) + "\"},\n";
+        }
+        std::string valid = text + "  {\"type\": \"option\", \"label\": \"Last\"}\n]}";
+        std::unique_ptr<mr::MenuPage> root = parse(valid);
+        MENULIB_CHECK(root->getCount() == count + 1);
+        MENULIB_CHECK(root->getItem(count - 1)->getLabel() == "Option " + std::to_string(count - 1));
+
+        checkRejected(text + "  {\"type\": \"option\", \"label\": \"Last\" \"x\"}\n]}", count + 2, 38);
+    });
+
+    return test::finish();
+}